@@ -29,4 +29,14 @@ do
     chmod 660 /opt/dbspace/.$name.db-journal
 done
 
+# wrt database is opened in WAL mode, WAL files must be shared as well
+rm -f /opt/dbspace/.wrt.db-wal /opt/dbspace/.wrt.db-shm
+sqlite3 /opt/dbspace/.wrt.db "PRAGMA journal_mode = WAL;"
+for suffix in wal shm
+do
+    touch /opt/dbspace/.wrt.db-$suffix
+    chown 0:6026 /opt/dbspace/.wrt.db-$suffix
+    chmod 660 /opt/dbspace/.wrt.db-$suffix
+done
+
 
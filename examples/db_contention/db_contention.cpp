@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        db_contention.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of database contention benchmark
+ */
+#include <dpl/db/sql_connection.h>
+#include <dpl/db/backoff_synchronization_object.h>
+#include <dpl/db/naive_synchronization_object.h>
+#include <dpl/exception.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+
+namespace // anonymous
+{
+const char *DATABASE_FILE = "/tmp/dpl_db_contention.db";
+
+int g_transactions = 0;
+bool g_naive = false;
+
+double GetMonotonicTime()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) / 1e9;
+}
+
+DPL::DB::SqlConnection::SynchronizationObject *AllocSynchronizationObject()
+{
+    if (g_naive)
+        return new DPL::DB::NaiveSynchronizationObject();
+
+    return new DPL::DB::BackoffSynchronizationObject();
+}
+
+DPL::DB::SqlConnection *OpenConnection()
+{
+    return new DPL::DB::SqlConnection(DATABASE_FILE,
+                                      DPL::DB::SqlConnection::Flag::None,
+                                      DPL::DB::SqlConnection::Flag::RW,
+                                      AllocSynchronizationObject());
+}
+
+// Short write transactions, every thread collides with all the others
+void *Writer(void *)
+{
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        DPL::DB::SqlConnection *connection = OpenConnection();
+
+        {
+            DPL::DB::SqlConnection::DataCommandAutoPtr insert =
+                connection->PrepareDataCommand(
+                    "INSERT INTO data (value) VALUES (?);");
+
+            for (int i = 0; i < g_transactions; ++i)
+            {
+                connection->ExecCommand("BEGIN IMMEDIATE;");
+
+                for (int row = 0; row < 10; ++row)
+                {
+                    insert->BindInteger(1, row);
+                    insert->Step();
+                    insert->Reset();
+                }
+
+                connection->ExecCommand("COMMIT;");
+            }
+        }
+
+        delete connection;
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return NULL;
+}
+
+// Cost of synchronization bookkeeping when nobody collides
+void MeasureUncontendedSteps(int steps)
+{
+    DPL::DB::SqlConnection *connection = OpenConnection();
+
+    {
+        DPL::DB::SqlConnection::DataCommandAutoPtr select =
+            connection->PrepareDataCommand("SELECT 1;");
+
+        double start = GetMonotonicTime();
+
+        for (int i = 0; i < steps; ++i)
+        {
+            select->Step();
+            select->Reset();
+        }
+
+        double time = GetMonotonicTime() - start;
+
+        std::cout << "Uncontended: " << steps << " steps in "
+                  << time * 1000.0 << " ms ("
+                  << time * 1e9 / steps << " ns per step)" << std::endl;
+    }
+
+    delete connection;
+}
+} // namespace anonymous
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3 || argc > 4)
+    {
+        std::cout << "Invalid parameters: db_contention [threads] "
+                     "[transactions_per_thread] [OPTIONAL: naive]"
+                  << std::endl;
+        return -1;
+    }
+
+    int threads = atoi(argv[1]);
+    g_transactions = atoi(argv[2]);
+    g_naive = argc == 4 && std::string(argv[3]) == "naive";
+
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        unlink(DATABASE_FILE);
+
+        {
+            DPL::DB::SqlConnection connection(DATABASE_FILE,
+                                              DPL::DB::SqlConnection::Flag::None,
+                                              DPL::DB::SqlConnection::Flag::CRW);
+            connection.ExecCommand(
+                "CREATE TABLE data (id INTEGER PRIMARY KEY, value INTEGER);");
+        }
+
+        MeasureUncontendedSteps(1000000);
+
+        pthread_t *writers = new pthread_t[threads];
+        double start = GetMonotonicTime();
+
+        for (int i = 0; i < threads; ++i)
+            pthread_create(&writers[i], NULL, &Writer, NULL);
+
+        for (int i = 0; i < threads; ++i)
+            pthread_join(writers[i], NULL);
+
+        double time = GetMonotonicTime() - start;
+        delete [] writers;
+
+        std::cout << "Contended: " << threads << " threads x "
+                  << g_transactions << " transactions in "
+                  << time * 1000.0 << " ms ("
+                  << threads * g_transactions / time
+                  << " transactions/s)" << std::endl;
+
+        if (!g_naive)
+        {
+            DPL::DB::BackoffSynchronizationObject::Statistics statistics =
+                DPL::DB::BackoffSynchronizationObject::GetStatistics();
+
+            std::cout << "Collisions: " << statistics.collisions
+                      << ", contended accesses: "
+                      << statistics.contendedAccesses
+                      << ", early wakeups: " << statistics.wakeups
+                      << ", timeouts: " << statistics.timeouts
+                      << ", max wait: " << statistics.maxWaitTime / 1000
+                      << " ms" << std::endl;
+        }
+
+        unlink(DATABASE_FILE);
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return 0;
+}
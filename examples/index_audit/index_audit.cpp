@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        index_audit.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of widget database index audit
+ */
+#include <dpl/db/sql_connection.h>
+#include <dpl/exception.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+
+namespace // anonymous
+{
+const char *DEFAULT_SCHEMA_FILE = "/usr/share/wrt-engine/wrt_db.sql";
+const char *DATABASE_FILE = "/tmp/dpl_index_audit.db";
+
+const int DEFAULT_WIDGET_COUNT = 1000;
+const int FEATURES_PER_WIDGET = 10;
+const int PARAMS_PER_FEATURE = 5;
+const int ICONS_PER_WIDGET = 3;
+const int PLUGIN_COUNT = 100;
+const int OBJECTS_PER_PLUGIN = 10;
+const int QUERY_REPEATS = 200;
+const int UNREGISTERED_WIDGETS = 100;
+
+// Column of EXPLAIN QUERY PLAN row with plan description
+const DPL::DB::SqlConnection::ColumnIndex PLAN_DETAIL_COLUMN = 3;
+
+int g_widgetCount = DEFAULT_WIDGET_COUNT;
+
+typedef DPL::DB::SqlConnection::DataCommand DataCommand;
+
+double GetMonotonicTime()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) / 1e9;
+}
+
+std::string WidgetId(int appId)
+{
+    std::ostringstream stream;
+    stream << "http://example.com/widget/" << appId;
+    return stream.str();
+}
+
+std::string PackageName(int appId)
+{
+    std::ostringstream stream;
+    stream << "pkg" << appId;
+    return stream.str();
+}
+
+std::string Name(const char *prefix, int number)
+{
+    std::ostringstream stream;
+    stream << prefix << number;
+    return stream.str();
+}
+
+// Spread consecutive lookups over the whole table
+int Pick(int iteration, int count)
+{
+    return static_cast<int>((iteration * 7919L) % count);
+}
+
+void BindWidgetId(DataCommand *command, int i)
+{
+    command->BindString(1, WidgetId(Pick(i, g_widgetCount)).c_str());
+}
+
+void BindPackageName(DataCommand *command, int i)
+{
+    command->BindString(1, PackageName(Pick(i, g_widgetCount)).c_str());
+}
+
+void BindAppId(DataCommand *command, int i)
+{
+    command->BindInteger(1, Pick(i, g_widgetCount));
+}
+
+void BindAppIdAndFeature(DataCommand *command, int i)
+{
+    command->BindInteger(1, Pick(i, g_widgetCount));
+    command->BindString(2, Name("feature", i % FEATURES_PER_WIDGET).c_str());
+}
+
+void BindAppIdAndLocale(DataCommand *command, int i)
+{
+    command->BindInteger(1, Pick(i, g_widgetCount));
+    command->BindString(2, "en");
+}
+
+void BindFeatureId(DataCommand *command, int i)
+{
+    command->BindInteger(1, Pick(i, g_widgetCount * FEATURES_PER_WIDGET));
+}
+
+void BindSubTag(DataCommand *command, int i)
+{
+    const char *SUBTAGS[] = { "en", "gb", "ko", "kr", "hant", "latn" };
+    const int SUBTAG_COUNT = sizeof(SUBTAGS) / sizeof(SUBTAGS[0]);
+
+    command->BindString(1, SUBTAGS[i % SUBTAG_COUNT]);
+}
+
+void BindPluginId(DataCommand *command, int i)
+{
+    command->BindInteger(1, Pick(i, PLUGIN_COUNT) + 1);
+}
+
+struct Query
+{
+    const char *name;
+    const char *statement;
+    void (*bind)(DataCommand *command, int iteration);
+};
+
+// Lookups done by widget DAO, feature DAO and plugin DAO
+const Query QUERIES[] = {
+    { "WidgetInfo by widget_id",
+      "SELECT app_id FROM WidgetInfo WHERE widget_id = ?;",
+      &BindWidgetId },
+    { "WidgetInfo by pkgname",
+      "SELECT app_id FROM WidgetInfo WHERE pkgname = ?;",
+      &BindPackageName },
+    { "WidgetFeature by app_id",
+      "SELECT * FROM WidgetFeature WHERE app_id = ?;",
+      &BindAppId },
+    { "WidgetFeature by app_id, name",
+      "SELECT * FROM WidgetFeature WHERE app_id = ? AND name = ?;",
+      &BindAppIdAndFeature },
+    { "FeatureParam by widget_feature_id",
+      "SELECT * FROM FeatureParam WHERE widget_feature_id = ?;",
+      &BindFeatureId },
+    { "WidgetIcon by app_id",
+      "SELECT * FROM WidgetIcon WHERE app_id = ?;",
+      &BindAppId },
+    { "WidgetLocalizedIcon by app_id, locale",
+      "SELECT * FROM WidgetLocalizedIcon "
+      "WHERE app_id = ? AND widget_locale = ?;",
+      &BindAppIdAndLocale },
+    { "WidgetStartFile by app_id",
+      "SELECT * FROM WidgetStartFile WHERE app_id = ?;",
+      &BindAppId },
+    { "WidgetLocalizedStartFile by app_id",
+      "SELECT * FROM WidgetLocalizedStartFile WHERE app_id = ?;",
+      &BindAppId },
+    { "WidgetCertificate by app_id",
+      "SELECT * FROM WidgetCertificate WHERE app_id = ?;",
+      &BindAppId },
+    { "WidgetWindowModes by app_id",
+      "SELECT * FROM WidgetWindowModes WHERE app_id = ?;",
+      &BindAppId },
+    { "SettginsList by appId",
+      "SELECT * FROM SettginsList WHERE appId = ?;",
+      &BindAppId },
+    { "EncryptedResourceList by app_id",
+      "SELECT * FROM EncryptedResourceList WHERE app_id = ?;",
+      &BindAppId },
+    { "iana_records by SUBTAG",
+      "SELECT TYPE FROM iana_records WHERE SUBTAG = ?;",
+      &BindSubTag },
+    { "PluginImplementedObjects by plugin",
+      "SELECT PluginObject FROM PluginImplementedObjects "
+      "WHERE PluginPropertiesId = ?;",
+      &BindPluginId },
+    { "PluginRequiredObjects by plugin",
+      "SELECT PluginObject FROM PluginRequiredObjects "
+      "WHERE PluginPropertiesId = ?;",
+      &BindPluginId },
+    { "PluginDependencies by plugin",
+      "SELECT * FROM PluginDependencies WHERE PluginPropertiesId = ?;",
+      &BindPluginId },
+    { "FeaturesList by plugin",
+      "SELECT * FROM FeaturesList WHERE PluginPropertiesId = ?;",
+      &BindPluginId }
+};
+
+const size_t QUERY_COUNT = sizeof(QUERIES) / sizeof(QUERIES[0]);
+
+void Execute(DataCommand *command)
+{
+    while (command->Step())
+        ;
+
+    command->Reset();
+}
+
+void LoadSchema(DPL::DB::SqlConnection *connection, const char *schemaFile)
+{
+    std::ifstream file(schemaFile);
+
+    if (!file)
+    {
+        std::cout << "Cannot read schema: " << schemaFile << std::endl;
+        exit(-1);
+    }
+
+    std::ostringstream schema;
+    schema << file.rdbuf();
+
+    connection->ExecCommand("%s", schema.str().c_str());
+}
+
+void InsertWidgets(DPL::DB::SqlConnection *connection)
+{
+    DPL::DB::SqlConnection::DataCommandAutoPtr widget =
+        connection->PrepareDataCommand(
+            "INSERT INTO WidgetInfo (app_id, widget_id, pkgname) "
+            "VALUES (?, ?, ?);");
+    DPL::DB::SqlConnection::DataCommandAutoPtr feature =
+        connection->PrepareDataCommand(
+            "INSERT INTO WidgetFeature "
+            "(widget_feature_id, app_id, name, required, rejected) "
+            "VALUES (?, ?, ?, 1, 0);");
+    DPL::DB::SqlConnection::DataCommandAutoPtr param =
+        connection->PrepareDataCommand(
+            "INSERT INTO FeatureParam (widget_feature_id, name, value) "
+            "VALUES (?, ?, 'value');");
+    DPL::DB::SqlConnection::DataCommandAutoPtr icon =
+        connection->PrepareDataCommand(
+            "INSERT INTO WidgetIcon (icon_id, app_id, icon_src) "
+            "VALUES (?, ?, ?);");
+    DPL::DB::SqlConnection::DataCommandAutoPtr localizedIcon =
+        connection->PrepareDataCommand(
+            "INSERT INTO WidgetLocalizedIcon "
+            "(app_id, icon_id, widget_locale) VALUES (?, ?, ?);");
+    DPL::DB::SqlConnection::DataCommandAutoPtr startFile =
+        connection->PrepareDataCommand(
+            "INSERT INTO WidgetStartFile (start_file_id, app_id, src) "
+            "VALUES (?, ?, 'index.html');");
+    DPL::DB::SqlConnection::DataCommandAutoPtr localizedStartFile =
+        connection->PrepareDataCommand(
+            "INSERT INTO WidgetLocalizedStartFile "
+            "(app_id, start_file_id, widget_locale, type, encoding) "
+            "VALUES (?, ?, 'en', 'text/html', 'UTF-8');");
+    DPL::DB::SqlConnection::DataCommandAutoPtr certificate =
+        connection->PrepareDataCommand(
+            "INSERT INTO WidgetCertificate (app_id, encoded_chain) "
+            "VALUES (?, 'chain');");
+    DPL::DB::SqlConnection::DataCommandAutoPtr windowMode =
+        connection->PrepareDataCommand(
+            "INSERT INTO WidgetWindowModes (app_id, window_mode) "
+            "VALUES (?, 'floating');");
+    DPL::DB::SqlConnection::DataCommandAutoPtr setting =
+        connection->PrepareDataCommand(
+            "INSERT INTO SettginsList (appId, settingName, settingValue) "
+            "VALUES (?, 'screen-orientation', 'portrait');");
+    DPL::DB::SqlConnection::DataCommandAutoPtr resource =
+        connection->PrepareDataCommand(
+            "INSERT INTO EncryptedResourceList (app_id, resource, size) "
+            "VALUES (?, 'index.html', 1024);");
+
+    int featureId = 0;
+
+    for (int appId = 0; appId < g_widgetCount; ++appId)
+    {
+        widget->BindInteger(1, appId);
+        widget->BindString(2, WidgetId(appId).c_str());
+        widget->BindString(3, PackageName(appId).c_str());
+        Execute(widget.get());
+
+        for (int i = 0; i < FEATURES_PER_WIDGET; ++i, ++featureId)
+        {
+            feature->BindInteger(1, featureId);
+            feature->BindInteger(2, appId);
+            feature->BindString(3, Name("feature", i).c_str());
+            Execute(feature.get());
+
+            for (int j = 0; j < PARAMS_PER_FEATURE; ++j)
+            {
+                param->BindInteger(1, featureId);
+                param->BindString(2, Name("param", j).c_str());
+                Execute(param.get());
+            }
+        }
+
+        for (int i = 0; i < ICONS_PER_WIDGET; ++i)
+        {
+            int iconId = appId * ICONS_PER_WIDGET + i + 1;
+
+            icon->BindInteger(1, iconId);
+            icon->BindInteger(2, appId);
+            icon->BindString(3, Name("icon", i).c_str());
+            Execute(icon.get());
+
+            localizedIcon->BindInteger(1, appId);
+            localizedIcon->BindInteger(2, iconId);
+            localizedIcon->BindString(3, i == 0 ? "en" : "ko");
+            Execute(localizedIcon.get());
+        }
+
+        startFile->BindInteger(1, appId + 1);
+        startFile->BindInteger(2, appId);
+        Execute(startFile.get());
+
+        localizedStartFile->BindInteger(1, appId);
+        localizedStartFile->BindInteger(2, appId + 1);
+        Execute(localizedStartFile.get());
+
+        certificate->BindInteger(1, appId);
+        Execute(certificate.get());
+
+        windowMode->BindInteger(1, appId);
+        Execute(windowMode.get());
+
+        setting->BindInteger(1, appId);
+        Execute(setting.get());
+
+        resource->BindInteger(1, appId);
+        Execute(resource.get());
+    }
+}
+
+void InsertPlugins(DPL::DB::SqlConnection *connection)
+{
+    DPL::DB::SqlConnection::DataCommandAutoPtr plugin =
+        connection->PrepareDataCommand(
+            "INSERT INTO PluginProperties "
+            "(PluginPropertiesId, PluginLibraryName) VALUES (?, ?);");
+    DPL::DB::SqlConnection::DataCommandAutoPtr implemented =
+        connection->PrepareDataCommand(
+            "INSERT INTO PluginImplementedObjects "
+            "(PluginObject, PluginPropertiesId) VALUES (?, ?);");
+    DPL::DB::SqlConnection::DataCommandAutoPtr required =
+        connection->PrepareDataCommand(
+            "INSERT INTO PluginRequiredObjects "
+            "(PluginPropertiesId, PluginObject) VALUES (?, ?);");
+    DPL::DB::SqlConnection::DataCommandAutoPtr dependency =
+        connection->PrepareDataCommand(
+            "INSERT INTO PluginDependencies "
+            "(PluginPropertiesId, RequiredPluginPropertiesId) "
+            "VALUES (?, ?);");
+    DPL::DB::SqlConnection::DataCommandAutoPtr feature =
+        connection->PrepareDataCommand(
+            "INSERT INTO FeaturesList (FeatureName, PluginPropertiesId) "
+            "VALUES (?, ?);");
+
+    for (int pluginId = 1; pluginId <= PLUGIN_COUNT; ++pluginId)
+    {
+        plugin->BindInteger(1, pluginId);
+        plugin->BindString(2, Name("libplugin", pluginId).c_str());
+        Execute(plugin.get());
+
+        for (int i = 0; i < OBJECTS_PER_PLUGIN; ++i)
+        {
+            int object = pluginId * OBJECTS_PER_PLUGIN + i;
+
+            implemented->BindString(1, Name("object", object).c_str());
+            implemented->BindInteger(2, pluginId);
+            Execute(implemented.get());
+
+            required->BindInteger(1, pluginId);
+            required->BindString(2, Name("required", object).c_str());
+            Execute(required.get());
+        }
+
+        dependency->BindInteger(1, pluginId);
+        dependency->BindInteger(2, pluginId % PLUGIN_COUNT + 1);
+        Execute(dependency.get());
+
+        feature->BindString(1, Name("feature", pluginId).c_str());
+        feature->BindInteger(2, pluginId);
+        Execute(feature.get());
+    }
+}
+
+// Returns true if any step of query plan reads a whole table
+bool AuditQuery(DPL::DB::SqlConnection *connection, const Query &query)
+{
+    DPL::DB::SqlConnection::DataCommandAutoPtr plan =
+        connection->PrepareDataCommand("EXPLAIN QUERY PLAN %s",
+                                       query.statement);
+    query.bind(plan.get(), 0);
+
+    std::string description;
+    bool fullScan = false;
+
+    while (plan->Step())
+    {
+        std::string detail = plan->GetColumnString(PLAN_DETAIL_COLUMN);
+
+        if (detail.compare(0, 4, "SCAN") == 0 &&
+            detail.find("INDEX") == std::string::npos)
+        {
+            fullScan = true;
+        }
+
+        if (!description.empty())
+            description += " / ";
+
+        description += detail;
+    }
+
+    DPL::DB::SqlConnection::DataCommandAutoPtr command =
+        connection->PrepareDataCommand(query.statement);
+
+    double start = GetMonotonicTime();
+
+    for (int i = 0; i < QUERY_REPEATS; ++i)
+    {
+        query.bind(command.get(), i);
+        Execute(command.get());
+    }
+
+    double time = (GetMonotonicTime() - start) * 1e6 / QUERY_REPEATS;
+
+    std::cout << (fullScan ? "FULL SCAN " : "          ")
+              << std::left << std::setw(40) << query.name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1)
+              << time << " us  " << description << std::endl;
+
+    return fullScan;
+}
+
+// Widget uninstallation cascades to all tables referencing WidgetInfo
+void MeasureUnregister(DPL::DB::SqlConnection *connection)
+{
+    DPL::DB::SqlConnection::DataCommandAutoPtr command =
+        connection->PrepareDataCommand(
+            "DELETE FROM WidgetInfo WHERE app_id = ?;");
+
+    int count = std::min(UNREGISTERED_WIDGETS, g_widgetCount);
+    double start = GetMonotonicTime();
+
+    for (int appId = 0; appId < count; ++appId)
+    {
+        command->BindInteger(1, appId);
+        Execute(command.get());
+    }
+
+    double time = (GetMonotonicTime() - start) * 1e6 / count;
+
+    std::cout << "          " << std::left << std::setw(40)
+              << "Unregister widget (cascade)" << std::right
+              << std::setw(10) << time << " us" << std::endl;
+}
+} // namespace anonymous
+
+int main(int argc, char *argv[])
+{
+    if (argc > 3)
+    {
+        std::cout << "Invalid parameters: index_audit "
+                     "[OPTIONAL: schema_sql] [OPTIONAL: widgets]"
+                  << std::endl;
+        return -1;
+    }
+
+    const char *schemaFile = argc > 1 ? argv[1] : DEFAULT_SCHEMA_FILE;
+
+    if (argc > 2)
+        g_widgetCount = atoi(argv[2]);
+
+    size_t fullScans = 0;
+
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        unlink(DATABASE_FILE);
+
+        {
+            DPL::DB::SqlConnection connection(
+                DATABASE_FILE,
+                DPL::DB::SqlConnection::Flag::None,
+                DPL::DB::SqlConnection::Flag::CRW);
+
+            LoadSchema(&connection, schemaFile);
+
+            connection.ExecCommand("BEGIN;");
+            InsertWidgets(&connection);
+            InsertPlugins(&connection);
+            connection.ExecCommand("COMMIT;");
+
+            std::cout << g_widgetCount << " widgets, " << PLUGIN_COUNT
+                      << " plugins, average time of " << QUERY_REPEATS
+                      << " lookups:" << std::endl;
+
+            for (size_t i = 0; i < QUERY_COUNT; ++i)
+            {
+                if (AuditQuery(&connection, QUERIES[i]))
+                    ++fullScans;
+            }
+
+            MeasureUnregister(&connection);
+        }
+
+        unlink(DATABASE_FILE);
+
+        std::cout << fullScans << " of " << QUERY_COUNT
+                  << " lookups do full table scans" << std::endl;
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return fullScans == 0 ? 0 : 1;
+}
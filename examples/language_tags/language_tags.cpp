@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        language_tags.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of language tag validation benchmark
+ */
+#include <dpl/wrt-dao-ro/global_dao_read_only.h>
+#include <dpl/wrt-dao-ro/WrtDatabase.h>
+#include <dpl/exception.h>
+#include <pthread.h>
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+namespace // anonymous
+{
+// Subtags of xml:lang values typically found in config.xml, with IANA
+// record types: 0 - language, 1 - script, 2 - region
+struct SubTag
+{
+    const wchar_t *subTag;
+    int type;
+};
+
+const SubTag SUBTAGS[] = {
+    { L"en", 0 }, { L"gb", 2 }, { L"us", 2 },
+    { L"ko", 0 }, { L"kr", 2 },
+    { L"pl", 0 }, { L"de", 0 }, { L"fr", 0 },
+    { L"zh", 0 }, { L"hant", 1 }, { L"tw", 2 },
+    { L"latn", 1 }, { L"xx", 0 }
+};
+
+const size_t SUBTAG_COUNT = sizeof(SUBTAGS) / sizeof(SUBTAGS[0]);
+
+int g_iterations = 0;
+
+double GetMonotonicTime()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) / 1e9;
+}
+
+void *Validate(void *)
+{
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        WrtDB::WrtDatabase::attachToThreadRO();
+
+        for (int i = 0; i < g_iterations; ++i)
+        {
+            const SubTag &tag = SUBTAGS[i % SUBTAG_COUNT];
+            WrtDB::GlobalDAOReadOnly::IsValidSubTag(tag.subTag, tag.type);
+        }
+
+        WrtDB::WrtDatabase::detachFromThread();
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return NULL;
+}
+} // namespace anonymous
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cout << "Invalid parameters: language_tags [threads] "
+                     "[lookups_per_thread]" << std::endl;
+        return -1;
+    }
+
+    int threads = atoi(argv[1]);
+    g_iterations = atoi(argv[2]);
+
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        // First lookup loads subtag index
+        WrtDB::WrtDatabase::attachToThreadRO();
+
+        double start = GetMonotonicTime();
+        WrtDB::GlobalDAOReadOnly::IsValidSubTag(L"en", 0);
+
+        std::cout << "First lookup: " << (GetMonotonicTime() - start) * 1000.0
+                  << " ms" << std::endl;
+
+        WrtDB::WrtDatabase::detachFromThread();
+
+        pthread_t *validators = new pthread_t[threads];
+        start = GetMonotonicTime();
+
+        for (int i = 0; i < threads; ++i)
+            pthread_create(&validators[i], NULL, &Validate, NULL);
+
+        for (int i = 0; i < threads; ++i)
+            pthread_join(validators[i], NULL);
+
+        double time = GetMonotonicTime() - start;
+        delete [] validators;
+
+        std::cout << threads << " threads x " << g_iterations
+                  << " lookups in " << time * 1000.0 << " ms ("
+                  << time * 1e9 / (threads * g_iterations)
+                  << " ns per lookup)" << std::endl;
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return 0;
+}
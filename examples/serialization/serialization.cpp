@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        serialization.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of serialization benchmark
+ */
+#include <dpl/serialization.h>
+#include <dpl/buffer_stream.h>
+#include <dpl/exception.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <cstdlib>
+#include <ctime>
+
+namespace // anonymous
+{
+const int DEFAULT_ROUND_TRIPS = 50;
+const int MAP_SIZE = 200;
+const int LIST_SIZE = 10;
+const int VECTOR_SIZE = 100;
+
+typedef std::map<int, std::list<std::vector<int> > > IntegerPayload;
+typedef std::map<std::string, std::list<std::string> > StringPayload;
+
+double GetMonotonicTime()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) / 1e9;
+}
+
+// Counts stream calls, which are virtual and done per element
+// without bulk paths
+class CountingStream
+    : public DPL::BufferStream
+{
+private:
+    size_t m_calls;
+
+public:
+    CountingStream()
+        : m_calls(0)
+    {
+    }
+
+    virtual void Read(size_t num, void *bytes)
+    {
+        ++m_calls;
+        DPL::BufferStream::Read(num, bytes);
+    }
+
+    virtual void Write(size_t num, const void *bytes)
+    {
+        ++m_calls;
+        DPL::BufferStream::Write(num, bytes);
+    }
+
+    size_t GetCalls() const
+    {
+        return m_calls;
+    }
+};
+
+IntegerPayload CreateIntegerPayload()
+{
+    IntegerPayload payload;
+
+    for (int key = 0; key < MAP_SIZE; ++key)
+    {
+        std::list<std::vector<int> > &list = payload[key];
+
+        for (int i = 0; i < LIST_SIZE; ++i)
+        {
+            std::vector<int> vector(VECTOR_SIZE);
+
+            for (int j = 0; j < VECTOR_SIZE; ++j)
+                vector[j] = key * j + i;
+
+            list.push_back(vector);
+        }
+    }
+
+    return payload;
+}
+
+// Names like those in widget configuration: features and device caps
+StringPayload CreateStringPayload()
+{
+    StringPayload payload;
+
+    for (int key = 0; key < MAP_SIZE; ++key)
+    {
+        std::ostringstream name;
+        name << "http://tizen.org/api/feature" << key;
+
+        std::list<std::string> &list = payload[name.str()];
+
+        for (int i = 0; i < LIST_SIZE; ++i)
+        {
+            std::ostringstream capability;
+            capability << "devcap.category" << key << ".capability" << i;
+            list.push_back(capability.str());
+        }
+    }
+
+    return payload;
+}
+
+template<typename Payload>
+void Measure(const char *name, const Payload &payload, int roundTrips)
+{
+    size_t calls = 0;
+    size_t bytes = 0;
+    bool same = true;
+
+    double start = GetMonotonicTime();
+
+    for (int i = 0; i < roundTrips; ++i)
+    {
+        CountingStream stream;
+        DPL::Serialization::Serialize(stream, payload);
+        bytes = stream.Size();
+
+        Payload result;
+        DPL::Deserialization::Deserialize(stream, result);
+
+        calls += stream.GetCalls();
+        same = same && result == payload;
+    }
+
+    double time = GetMonotonicTime() - start;
+
+    std::cout << name << ": " << roundTrips << " round trips of "
+              << bytes << " bytes in " << time * 1000.0 << " ms, "
+              << calls / roundTrips << " stream calls per round trip"
+              << (same ? "" : ", RESULT DIFFERS") << std::endl;
+}
+} // namespace anonymous
+
+int main(int argc, char *argv[])
+{
+    int roundTrips = argc > 1 ? atoi(argv[1]) : DEFAULT_ROUND_TRIPS;
+
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        Measure("Map of lists of int vectors", CreateIntegerPayload(),
+                roundTrips);
+        Measure("Map of lists of strings", CreateStringPayload(),
+                roundTrips);
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return 0;
+}
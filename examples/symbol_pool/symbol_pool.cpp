@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        symbol_pool.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of symbol pool benchmark
+ */
+#include <dpl/symbol.h>
+#include <dpl/string.h>
+#include <dpl/exception.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <new>
+#include <malloc.h>
+#include <cstdlib>
+#include <ctime>
+
+namespace // anonymous
+{
+const int DEFAULT_WIDGET_COUNT = 1000;
+const int FEATURE_NAME_COUNT = 50;
+const int FEATURES_PER_WIDGET = 10;
+const int LOOKUP_ROUNDS = 100;
+
+size_t g_allocatedBytes = 0;
+} // namespace anonymous
+
+// Count live heap bytes to compare footprint of feature sets
+void *operator new(size_t size)
+{
+    void *memory = malloc(size);
+
+    if (!memory)
+        throw std::bad_alloc();
+
+    g_allocatedBytes += malloc_usable_size(memory);
+    return memory;
+}
+
+void operator delete(void *memory)
+{
+    g_allocatedBytes -= malloc_usable_size(memory);
+    free(memory);
+}
+
+namespace // anonymous
+{
+double GetMonotonicTime()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) / 1e9;
+}
+
+// Feature names as read from database, a fresh string for every row
+DPL::String FeatureName(int number)
+{
+    std::ostringstream name;
+    name << "http://tizen.org/api/feature" << number;
+    return DPL::FromASCIIString(name.str());
+}
+
+int FeatureOf(int widget, int feature)
+{
+    return (widget * 7 + feature * 3) % FEATURE_NAME_COUNT;
+}
+
+// Per widget feature sets, as kept by a long running runtime
+template<typename Type>
+void Measure(const char *name, int widgets)
+{
+    typedef std::set<Type> FeatureSet;
+
+    size_t before = g_allocatedBytes;
+    double start = GetMonotonicTime();
+
+    std::vector<FeatureSet> sets(widgets);
+
+    for (int widget = 0; widget < widgets; ++widget)
+    {
+        for (int i = 0; i < FEATURES_PER_WIDGET; ++i)
+            sets[widget].insert(Type(FeatureName(FeatureOf(widget, i))));
+    }
+
+    double buildTime = GetMonotonicTime() - start;
+    size_t bytes = g_allocatedBytes - before;
+
+    // Which widgets use given feature, key converted once per query
+    std::vector<Type> keys;
+
+    for (int i = 0; i < FEATURE_NAME_COUNT; ++i)
+        keys.push_back(Type(FeatureName(i)));
+
+    size_t found = 0;
+    start = GetMonotonicTime();
+
+    for (int round = 0; round < LOOKUP_ROUNDS; ++round)
+    {
+        const Type &key = keys[round % FEATURE_NAME_COUNT];
+
+        for (int widget = 0; widget < widgets; ++widget)
+            found += sets[widget].count(key);
+    }
+
+    double lookupTime = GetMonotonicTime() - start;
+    int lookups = LOOKUP_ROUNDS * widgets;
+
+    std::cout << name << ": " << widgets << " feature sets built in "
+              << buildTime * 1000.0 << " ms, " << bytes / 1024
+              << " KiB; " << lookups << " lookups in "
+              << lookupTime * 1000.0 << " ms ("
+              << lookupTime * 1e9 / lookups << " ns per lookup, "
+              << found << " found)" << std::endl;
+}
+
+// Interning cost when name is already pooled, paid once per name read
+void MeasureInterning()
+{
+    std::vector<DPL::String> names;
+
+    for (int i = 0; i < FEATURE_NAME_COUNT; ++i)
+        names.push_back(FeatureName(i));
+
+    const int ITERATIONS = 1000000;
+    double start = GetMonotonicTime();
+
+    for (int i = 0; i < ITERATIONS; ++i)
+        DPL::Symbol symbol(names[i % FEATURE_NAME_COUNT]);
+
+    double time = GetMonotonicTime() - start;
+
+    std::cout << "Interning pooled name: " << time * 1e9 / ITERATIONS
+              << " ns, pool size " << DPL::Symbol::GetPoolSize()
+              << std::endl;
+}
+} // namespace anonymous
+
+int main(int argc, char *argv[])
+{
+    int widgets = argc > 1 ? atoi(argv[1]) : DEFAULT_WIDGET_COUNT;
+
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        Measure<DPL::String>("DPL::String", widgets);
+        Measure<DPL::Symbol>("DPL::Symbol", widgets);
+        MeasureInterning();
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        utf8_conversion.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of UTF-8 conversion benchmark
+ */
+#include <dpl/string.h>
+#include <dpl/exception.h>
+#include <iconv.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+
+namespace // anonymous
+{
+const char *SAMPLES[] = {
+    "http://www.example.com/widget/index.html",
+    "Hello World Widget",
+    "ko-KR",
+    "Za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87 g\xc4\x99\xc5\x9bl\xc4\x85 ja\xc5\xba\xc5\x84",
+    "\xec\x95\x88\xeb\x85\x95\xed\x95\x98\xec\x84\xb8\xec\x9a\x94 "
+    "\xec\x9c\x84\xec\xa0\xaf"
+};
+
+double GetMonotonicTime()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) / 1e9;
+}
+
+// Reference conversion with iconv handle opened for every call
+std::string IconvConvert(const char *to,
+                         const char *from,
+                         const char *data,
+                         size_t size)
+{
+    iconv_t handle = iconv_open(to, from);
+
+    if (handle == reinterpret_cast<iconv_t>(-1))
+        abort();
+
+    std::vector<char> output(size * 4 + 8);
+    char *in = const_cast<char *>(data);
+    char *out = &output[0];
+    size_t inLeft = size;
+    size_t outLeft = output.size();
+
+    iconv(handle, &in, &inLeft, &out, &outLeft);
+    iconv_close(handle);
+
+    return std::string(&output[0], output.size() - outLeft);
+}
+
+template<typename Function>
+double Measure(Function function, int iterations)
+{
+    double start = GetMonotonicTime();
+
+    for (int i = 0; i < iterations; ++i)
+        function();
+
+    return (GetMonotonicTime() - start) * 1e9 / iterations;
+}
+
+struct FromUTF8
+{
+    const std::string &input;
+    explicit FromUTF8(const std::string &i) : input(i) {}
+    void operator()() const { DPL::FromUTF8String(input); }
+};
+
+struct ToUTF8
+{
+    const DPL::String &input;
+    explicit ToUTF8(const DPL::String &i) : input(i) {}
+    void operator()() const { DPL::ToUTF8String(input); }
+};
+
+struct IconvFromUTF8
+{
+    const std::string &input;
+    explicit IconvFromUTF8(const std::string &i) : input(i) {}
+
+    void operator()() const
+    {
+        IconvConvert("WCHAR_T", "UTF-8", input.data(), input.size());
+    }
+};
+
+struct IconvToUTF8
+{
+    const DPL::String &input;
+    explicit IconvToUTF8(const DPL::String &i) : input(i) {}
+
+    void operator()() const
+    {
+        IconvConvert("UTF-8", "WCHAR_T",
+                     reinterpret_cast<const char *>(input.data()),
+                     input.size() * sizeof(wchar_t));
+    }
+};
+} // namespace anonymous
+
+int main(int argc, char *argv[])
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        std::cout << "Average time per conversion [ns]: "
+                     "from UTF-8 (iconv, DPL), to UTF-8 (iconv, DPL)"
+                  << std::endl;
+
+        for (size_t i = 0; i < sizeof(SAMPLES) / sizeof(SAMPLES[0]); ++i)
+        {
+            std::string utf8 = SAMPLES[i];
+            DPL::String wide = DPL::FromUTF8String(utf8);
+
+            std::cout << utf8 << ": "
+                      << Measure(IconvFromUTF8(utf8), iterations) << ", "
+                      << Measure(FromUTF8(utf8), iterations) << ", "
+                      << Measure(IconvToUTF8(wide), iterations) << ", "
+                      << Measure(ToUTF8(wide), iterations) << std::endl;
+        }
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return 0;
+}
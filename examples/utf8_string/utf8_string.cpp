@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        utf8_string.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of UTF-8 string catalog benchmark
+ */
+#include <dpl/db/sql_connection.h>
+#include <dpl/db/orm.h>
+#include <dpl/utf8_string.h>
+#include <dpl/string.h>
+#include <dpl/exception.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <new>
+#include <malloc.h>
+#include <cstdlib>
+#include <ctime>
+
+namespace // anonymous
+{
+const int DEFAULT_WIDGET_COUNT = 1000;
+const int STRINGS_PER_WIDGET = 20;
+
+size_t g_allocatedBytes = 0;
+
+// Localized names and descriptions of installed widgets
+const char *SAMPLES[] = {
+    "http://tizen.org/privilege/application.launch",
+    "Calculator",
+    "Simple calculator widget with scientific functions",
+    "Kalkulator",
+    "Prosty kalkulator z funkcjami naukowymi \xc5\xbc\xc3\xb3\xc5\x82\xc4\x87",
+    "\xea\xb3\x84\xec\x82\xb0\xea\xb8\xb0",
+    "\xea\xb3\xb5\xed\x95\x99\xec\x9a\xa9 \xea\xb3\x84\xec\x82\xb0\xea\xb8\xb0 "
+    "\xec\x9c\x84\xec\xa0\xaf",
+    "index.html",
+    "icon.png",
+    "ko-KR"
+};
+
+const int SAMPLE_COUNT = sizeof(SAMPLES) / sizeof(SAMPLES[0]);
+} // namespace anonymous
+
+// Count live heap bytes to compare catalog footprint
+void *operator new(size_t size)
+{
+    void *memory = malloc(size);
+
+    if (!memory)
+        throw std::bad_alloc();
+
+    g_allocatedBytes += malloc_usable_size(memory);
+    return memory;
+}
+
+void operator delete(void *memory)
+{
+    g_allocatedBytes -= malloc_usable_size(memory);
+    free(memory);
+}
+
+namespace // anonymous
+{
+double GetMonotonicTime()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) / 1e9;
+}
+
+void CreateCatalog(DPL::DB::SqlConnection *connection, int widgets)
+{
+    connection->ExecCommand(
+        "CREATE TABLE catalog (app_id INT, value TEXT);");
+    connection->ExecCommand("BEGIN;");
+
+    DPL::DB::SqlConnection::DataCommandAutoPtr insert =
+        connection->PrepareDataCommand(
+            "INSERT INTO catalog (app_id, value) VALUES (?, ?);");
+
+    for (int appId = 0; appId < widgets; ++appId)
+    {
+        for (int i = 0; i < STRINGS_PER_WIDGET; ++i)
+        {
+            insert->BindInteger(1, appId);
+            insert->BindString(2, SAMPLES[(appId + i) % SAMPLE_COUNT]);
+            insert->Step();
+            insert->Reset();
+        }
+    }
+
+    connection->ExecCommand("COMMIT;");
+}
+
+// Read whole catalog the way ORM reads columns of given type
+template<typename Type>
+void Measure(const char *name, DPL::DB::SqlConnection *connection)
+{
+    DPL::DB::SqlConnection::DataCommandAutoPtr select =
+        connection->PrepareDataCommand("SELECT value FROM catalog;");
+
+    std::vector<Type> catalog;
+    size_t before = g_allocatedBytes;
+    double start = GetMonotonicTime();
+
+    while (select->Step())
+        catalog.push_back(
+            DPL::DB::ORM::GetColumnFromCommand<Type>(0, select.get()));
+
+    double time = GetMonotonicTime() - start;
+
+    // Drop spare vector capacity, count strings only
+    std::vector<Type>(catalog).swap(catalog);
+    size_t bytes = g_allocatedBytes - before -
+        malloc_usable_size(&catalog[0]);
+
+    std::cout << name << ": " << catalog.size() << " strings read in "
+              << time * 1000.0 << " ms, " << bytes / 1024
+              << " KiB of string data" << std::endl;
+}
+} // namespace anonymous
+
+int main(int argc, char *argv[])
+{
+    int widgets = argc > 1 ? atoi(argv[1]) : DEFAULT_WIDGET_COUNT;
+
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        DPL::DB::SqlConnection connection(":memory:",
+                                          DPL::DB::SqlConnection::Flag::None,
+                                          DPL::DB::SqlConnection::Flag::CRW);
+
+        CreateCatalog(&connection, widgets);
+
+        Measure<DPL::String>("DPL::String", &connection);
+        Measure<DPL::UTF8String>("DPL::UTF8String", &connection);
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return 0;
+}
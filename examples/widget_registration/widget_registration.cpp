@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        widget_registration.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of widget registration benchmark
+ */
+#include <dpl/wrt-dao-rw/widget_dao.h>
+#include <dpl/wrt-dao-ro/WrtDatabase.h>
+#include <dpl/exception.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+
+namespace // anonymous
+{
+// Handles far above those given by installer
+const WrtDB::DbWidgetHandle FIRST_HANDLE = 1000000;
+
+const int DEFAULT_WIDGET_COUNT = 20;
+const int DEFAULT_PARAMS_PER_FEATURE = 20;
+const int FEATURE_COUNT = 20;
+const int PREFERENCE_COUNT = 50;
+
+double GetMonotonicTime()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) / 1e9;
+}
+
+DPL::String Name(const char *prefix, int number)
+{
+    std::ostringstream stream;
+    stream << prefix << number;
+    return DPL::FromASCIIString(stream.str());
+}
+
+class UnsignedWidget
+    : public WrtDB::IWacSecurity
+{
+  private:
+    WrtDB::WidgetCertificateDataList m_certificates;
+
+  public:
+    virtual const WrtDB::WidgetCertificateDataList &getCertificateList() const
+    {
+        return m_certificates;
+    }
+
+    virtual bool isRecognized() const
+    {
+        return false;
+    }
+
+    virtual bool isDistributorSigned() const
+    {
+        return false;
+    }
+
+    virtual bool isWacSigned() const
+    {
+        return false;
+    }
+
+    virtual void getCertificateChainList(
+        WrtDB::CertificateChainList &/*list*/) const
+    {
+    }
+};
+
+WrtDB::WidgetRegisterInfo CreateRegisterInfo(int widget, int params)
+{
+    WrtDB::WidgetRegisterInfo info;
+
+    info.configInfo.widget_id =
+        Name("http://example.com/registration/", widget);
+    info.pkgname = Name("registration", widget);
+    info.baseFolder = "/opt/apps/registration";
+    info.installedTime = time(NULL);
+
+    for (int i = 0; i < FEATURE_COUNT; ++i)
+    {
+        WrtDB::ConfigParserData::Feature feature(
+            Name("http://tizen.org/api/feature", i));
+
+        for (int j = 0; j < params; ++j)
+        {
+            WrtDB::ConfigParserData::Param param(Name("param", j));
+            param.value = Name("value", j);
+            feature.paramsList.insert(param);
+        }
+
+        info.configInfo.featuresList.insert(feature);
+    }
+
+    for (int i = 0; i < PREFERENCE_COUNT; ++i)
+    {
+        WrtDB::ConfigParserData::Preference preference(
+            Name("preference", i));
+        preference.value = Name("value", i);
+        info.configInfo.preferencesList.insert(preference);
+    }
+
+    return info;
+}
+} // namespace anonymous
+
+int main(int argc, char *argv[])
+{
+    if (argc > 3)
+    {
+        std::cout << "Invalid parameters: widget_registration "
+                     "[OPTIONAL: widgets] [OPTIONAL: params_per_feature]"
+                  << std::endl;
+        return -1;
+    }
+
+    int widgets = argc > 1 ? atoi(argv[1]) : DEFAULT_WIDGET_COUNT;
+    int params = argc > 2 ? atoi(argv[2]) : DEFAULT_PARAMS_PER_FEATURE;
+
+    UNHANDLED_EXCEPTION_HANDLER_BEGIN
+    {
+        WrtDB::WrtDatabase::attachToThreadRW();
+
+        UnsignedWidget security;
+        double registerTime = 0;
+        double unregisterTime = 0;
+
+        for (int i = 0; i < widgets; ++i)
+        {
+            WrtDB::WidgetRegisterInfo info = CreateRegisterInfo(i, params);
+            WrtDB::DbWidgetHandle handle = FIRST_HANDLE + i;
+
+            double start = GetMonotonicTime();
+            WrtDB::WidgetDAO::registerWidget(handle, info, security);
+            registerTime += GetMonotonicTime() - start;
+
+            start = GetMonotonicTime();
+            WrtDB::WidgetDAO::unregisterWidget(handle);
+            unregisterTime += GetMonotonicTime() - start;
+        }
+
+        WrtDB::WrtDatabase::detachFromThread();
+
+        std::cout << widgets << " widgets with " << FEATURE_COUNT
+                  << " features of " << params << " params and "
+                  << PREFERENCE_COUNT << " preferences: register "
+                  << registerTime * 1000.0 / widgets << " ms, unregister "
+                  << unregisterTime * 1000.0 / widgets << " ms"
+                  << std::endl;
+    }
+    UNHANDLED_EXCEPTION_HANDLER_END
+
+    return 0;
+}
@@ -24,6 +24,7 @@
 #include <wrt-commons/auto-save-dao/AutoSaveDatabase.h>
 #include <orm_generator_autosave.h>
 #include <dpl/foreach.h>
+#include "auto_save_writer.h"
 
 using namespace DPL::DB::ORM;
 using namespace DPL::DB::ORM::autosave;
@@ -31,15 +32,6 @@ using namespace AutoSaveDB::Interface;
 
 namespace AutoSaveDB {
 
-#define SQL_CONNECTION_EXCEPTION_HANDLER_BEGIN          Try
-
-#define SQL_CONNECTION_EXCEPTION_HANDLER_END(message)   \
-    Catch(DPL::DB::SqlConnection::Exception::Base) {       \
-        LogError(message);                              \
-        ReThrowMsg(AutoSaveDAO::Exception::DatabaseError, \
-                   message);                            \
-    }
-
 AutoSaveDAO::AutoSaveDAO() :
     AutoSaveDAOReadOnly()
 {
@@ -63,37 +55,29 @@ void AutoSaveDAO::detachDatabase(void)
 void AutoSaveDAO::setAutoSaveSubmitFormData(const DPL::String &url,
                                       const SubmitFormData &submitFormData)
 {
-    SQL_CONNECTION_EXCEPTION_HANDLER_BEGIN
-    {
-        ScopedTransaction transaction(&m_autoSavedbInterface);
-
-        SubmitFormData submitData = getAutoSaveSubmitFormData(url);
-        if (!submitData.empty()) {
-            AUTOSAVE_DB_DELETE(del,
-                               AutoSaveSubmitFormElement,
-                               &m_autoSavedbInterface)
-            del->Where(Equals<AutoSaveSubmitFormElement::address>(url));
-            del->Execute();
-        }
-
-        FOREACH(pSubmitFormData, submitFormData) {
-            AutoSaveSubmitFormElement::Row row;
-            row.Set_address(url);
-            row.Set_key(pSubmitFormData->key);
-            row.Set_value(pSubmitFormData->value);
-
-            AUTOSAVE_DB_INSERT(
-                insert, AutoSaveSubmitFormElement, &m_autoSavedbInterface);
-            insert->Values(row);
-            insert->Execute();
-        }
+    Try {
+        AutoSaveWriter::Store(url, submitFormData);
+    }
+    Catch(AutoSaveWriter::Exception::DatabaseError) {
+        ReThrowMsg(AutoSaveDAO::Exception::DatabaseError,
+                   "Fail to register id, passwd for autosave");
+    }
+}
 
-        transaction.Commit();
+void AutoSaveDAO::syncAutoSaveSubmitFormData(void)
+{
+    Try {
+        AutoSaveWriter::Sync();
+    }
+    Catch(AutoSaveWriter::Exception::DatabaseError) {
+        ReThrowMsg(AutoSaveDAO::Exception::DatabaseError,
+                   "Fail to write autosave data");
     }
-    SQL_CONNECTION_EXCEPTION_HANDLER_END(
-        "Fail to register id, passwd for autosave")
 }
-#undef SQL_CONNECTION_EXCEPTION_HANDLER_BEGIN
-#undef SQL_CONNECTION_EXCEPTION_HANDLER_END
+
+AutoSaveWriterStatistics AutoSaveDAO::getAutoSaveWriterStatistics(void)
+{
+    return AutoSaveWriter::GetStatistics();
+}
 
 } // namespace AutoSaveDB
@@ -26,6 +26,7 @@
 #include <wrt-commons/auto-save-dao/AutoSaveDatabase.h>
 #include <orm_generator_autosave.h>
 #include <dpl/foreach.h>
+#include "auto_save_writer.h"
 
 using namespace DPL::DB::ORM;
 using namespace DPL::DB::ORM::autosave;
@@ -65,6 +66,13 @@ void AutoSaveDAOReadOnly::detachDatabase(void)
 SubmitFormData AutoSaveDAOReadOnly::getAutoSaveSubmitFormData(
     const DPL::String &url)
 {
+    SubmitFormData queuedData;
+
+    // Data stored by this process may not be written yet
+    if (AutoSaveWriter::GetQueued(url, queuedData)) {
+        return queuedData;
+    }
+
     SQL_CONNECTION_EXCEPTION_HANDLER_BEGIN
     {
         AUTOSAVE_DB_SELECT(select, AutoSaveSubmitFormElement, &m_autoSavedbInterface);
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file    auto_save_writer.cpp
+ * @version 1.0
+ * @brief   This file contains the definition of asynchronous
+ *          submit form data writer
+ */
+
+#include "auto_save_writer.h"
+
+#include <list>
+#include <map>
+
+#include <dpl/db/deferred_writer.h>
+#include <dpl/foreach.h>
+#include <dpl/log/log.h>
+#include <dpl/monotonic_time.h>
+#include <dpl/mutex.h>
+#include <wrt-commons/auto-save-dao/AutoSaveDatabase.h>
+#include <orm_generator_autosave.h>
+
+using namespace AutoSaveDB::Interface;
+
+namespace AutoSaveDB {
+
+namespace {
+// Form submits closer than this are written in one transaction
+const double BATCH_DELAY = 0.5; // [s]
+
+// Caller writes the queue by itself when it has this many urls
+const size_t MAX_QUEUED_URLS = 64;
+
+struct QueuedData
+{
+    SubmitFormData submitFormData;
+    unsigned long generation; // Incremented on every store
+};
+
+typedef std::map<DPL::String, QueuedData> QueuedDataMap;
+
+DPL::Mutex g_queueMutex;
+QueuedDataMap g_queue;
+unsigned long g_generation = 0;
+AutoSaveWriterStatistics g_statistics = {};
+
+// Batches are serialized, so older data never overwrites newer one
+DPL::Mutex g_batchMutex;
+
+void WriteBatch()
+{
+    using namespace DPL::DB::ORM;
+    using namespace DPL::DB::ORM::autosave;
+
+    DPL::Mutex::ScopedLock batchLock(&g_batchMutex);
+
+    // Data stays queued until commit, so readers never miss it
+    QueuedDataMap batch;
+
+    {
+        DPL::Mutex::ScopedLock lock(&g_queueMutex);
+        batch = g_queue;
+    }
+
+    if (batch.empty()) {
+        return;
+    }
+
+    LogDebug("Writing autosave data of " << batch.size() << " urls");
+
+    uint64_t start = DPL::GetMonotonicTime();
+
+    Try {
+        ScopedTransaction transaction(&m_autoSavedbInterface);
+
+        AutoSaveSubmitFormElement::Delete del(&m_autoSavedbInterface);
+        AutoSaveSubmitFormElement::Insert insert(&m_autoSavedbInterface);
+
+        FOREACH(it, batch) {
+            del.Where(Equals<AutoSaveSubmitFormElement::address>(it->first));
+            del.Execute();
+
+            FOREACH(element, it->second.submitFormData) {
+                AutoSaveSubmitFormElement::Row row;
+                row.Set_address(it->first);
+                row.Set_key(element->key);
+                row.Set_value(element->value);
+                insert.Values(row);
+                insert.Execute();
+            }
+        }
+
+        transaction.Commit();
+    }
+    Catch(DPL::DB::SqlConnection::Exception::Base){
+        {
+            DPL::Mutex::ScopedLock lock(&g_queueMutex);
+
+            // Autosave data is not worth retrying forever
+            FOREACH(it, batch) {
+                QueuedDataMap::iterator queued = g_queue.find(it->first);
+
+                if (queued != g_queue.end() &&
+                    queued->second.generation == it->second.generation)
+                {
+                    g_queue.erase(queued);
+                }
+            }
+            ++g_statistics.failedBatches;
+        }
+
+        LogError("Failed to write autosave data of " << batch.size() <<
+                 " urls");
+        ReThrowMsg(AutoSaveWriter::Exception::DatabaseError,
+                   "Fail to write autosave data");
+    }
+
+    uint64_t time = DPL::GetMonotonicTime() - start;
+
+    DPL::Mutex::ScopedLock lock(&g_queueMutex);
+
+    FOREACH(it, batch) {
+        QueuedDataMap::iterator queued = g_queue.find(it->first);
+
+        // Url stored again during write stays queued
+        if (queued != g_queue.end() &&
+            queued->second.generation == it->second.generation)
+        {
+            g_queue.erase(queued);
+        }
+    }
+
+    ++g_statistics.batches;
+    g_statistics.batchedUrls += batch.size();
+    g_statistics.totalBatchTime += time;
+
+    if (time > g_statistics.maxBatchTime) {
+        g_statistics.maxBatchTime = time;
+    }
+}
+
+class BatchWriter :
+    public DPL::DB::DeferredWriter
+{
+  public:
+    BatchWriter() :
+        DPL::DB::DeferredWriter("autosave data")
+    {
+    }
+
+  protected:
+    virtual void AttachToThread()
+    {
+        m_autoSavedbInterface.AttachToThread(
+            DPL::DB::SqlConnection::Flag::RW);
+    }
+
+    virtual void DetachFromThread()
+    {
+        m_autoSavedbInterface.DetachFromThread();
+    }
+
+    virtual void Write()
+    {
+        WriteBatch();
+    }
+};
+
+BatchWriter g_writer;
+} // namespace
+
+void AutoSaveWriter::Store(const DPL::String &url,
+                           const SubmitFormData &submitFormData)
+{
+    bool writeNow = false;
+
+    {
+        DPL::Mutex::ScopedLock lock(&g_queueMutex);
+
+        ++g_statistics.writes;
+
+        QueuedDataMap::iterator it = g_queue.find(url);
+
+        if (it != g_queue.end()) {
+            ++g_statistics.coalescedWrites;
+        } else {
+            it = g_queue.insert(std::make_pair(url, QueuedData())).first;
+        }
+
+        it->second.submitFormData = submitFormData;
+        it->second.generation = ++g_generation;
+
+        if (g_queue.size() >= MAX_QUEUED_URLS) {
+            ++g_statistics.overflows;
+            writeNow = true;
+        } else {
+            g_writer.Schedule(BATCH_DELAY);
+        }
+    }
+
+    if (writeNow) {
+        WriteBatch();
+    }
+}
+
+bool AutoSaveWriter::GetQueued(const DPL::String &url,
+                               SubmitFormData &submitFormData)
+{
+    DPL::Mutex::ScopedLock lock(&g_queueMutex);
+
+    QueuedDataMap::const_iterator it = g_queue.find(url);
+
+    if (it == g_queue.end()) {
+        return false;
+    }
+
+    submitFormData = it->second.submitFormData;
+    return true;
+}
+
+void AutoSaveWriter::Sync()
+{
+    WriteBatch();
+}
+
+AutoSaveWriterStatistics AutoSaveWriter::GetStatistics()
+{
+    DPL::Mutex::ScopedLock lock(&g_queueMutex);
+    return g_statistics;
+}
+
+} // namespace AutoSaveDB
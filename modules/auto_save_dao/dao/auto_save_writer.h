@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file    auto_save_writer.h
+ * @version 1.0
+ * @brief   This file contains the declaration of asynchronous
+ *          submit form data writer
+ */
+#ifndef _AUTO_SAVE_WRITER_H_
+#define _AUTO_SAVE_WRITER_H_
+
+#include <dpl/string.h>
+#include <dpl/exception.h>
+#include <wrt-commons/auto-save-dao/common_dao_types.h>
+
+namespace AutoSaveDB {
+
+/**
+ * Asynchronous writer of submit form data
+ *
+ * Stored data is queued per url; newer data for queued url replaces the
+ * older one. Queue is written in single transaction by writer thread
+ * after batch delay, or at process exit. When queue is full, caller
+ * writes it in its own thread. Queued data is visible to readers of
+ * this process until it is committed.
+ */
+class AutoSaveWriter
+{
+  public:
+    class Exception
+    {
+      public:
+        DECLARE_EXCEPTION_TYPE(DPL::Exception, Base)
+        DECLARE_EXCEPTION_TYPE(Base, DatabaseError)
+    };
+
+    static void Store(const DPL::String &url,
+                      const SubmitFormData &submitFormData);
+
+    /**
+     * @return true when data of url is not written yet
+     */
+    static bool GetQueued(const DPL::String &url,
+                          SubmitFormData &submitFormData);
+
+    /**
+     * Writes queued data in calling thread
+     */
+    static void Sync();
+
+    static AutoSaveWriterStatistics GetStatistics();
+};
+
+} // namespace AutoSaveDB
+
+#endif // _AUTO_SAVE_WRITER_H_
@@ -39,10 +39,22 @@ class AutoSaveDAO : public AutoSaveDAOReadOnly
     static void detachDatabase(void);
 
     /**
-     * This method sets Autofill for Webkit
+     * This method sets Autofill for Webkit.
+     * Data is written asynchronously; getAutoSaveSubmitFormData of this
+     * process returns it immediately.
      */
     static void setAutoSaveSubmitFormData(
             const DPL::String& url, const SubmitFormData &submitFormData);
+
+    /**
+     * This method writes pending Autofill data in calling thread
+     */
+    static void syncAutoSaveSubmitFormData(void);
+
+    /**
+     * This method gets statistics of asynchronous Autofill writes
+     */
+    static AutoSaveWriterStatistics getAutoSaveWriterStatistics(void);
 };
 
 } // namespace AutoSaveDB
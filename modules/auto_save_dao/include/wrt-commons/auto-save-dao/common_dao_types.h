@@ -25,6 +25,7 @@
 #define SHARE_COMMON_DAO_TYPES_H_
 
 #include <list>
+#include <stdint.h>
 #include <dpl/string.h>
 
 namespace AutoSaveDB {
@@ -59,6 +60,21 @@ struct SubmitFormElement
 };
 typedef std::list<SubmitFormElement> SubmitFormData;
 
+/**
+ * Statistics of asynchronous submit form data writer, gathered in process
+ */
+struct AutoSaveWriterStatistics
+{
+    uint64_t writes;          ///< Submit form data stores
+    uint64_t coalescedWrites; ///< Stores replaced by newer one for same url
+    uint64_t batches;         ///< Committed write transactions
+    uint64_t failedBatches;   ///< Rolled back transactions; data is dropped
+    uint64_t batchedUrls;     ///< Urls written by committed transactions
+    uint64_t overflows;       ///< Stores written by caller as queue was full
+    uint64_t totalBatchTime;  ///< Time spent in write transactions [us]
+    uint64_t maxBatchTime;    ///< Longest write transaction [us]
+};
+
 } // namespace AutoSaveDB
 
 #endif /* SHARE_COMMON_DAO_TYPES_H_ */
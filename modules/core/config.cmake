@@ -29,6 +29,8 @@ SET(DPL_CORE_SOURCES
     ${PROJECT_SOURCE_DIR}/modules/core/src/assert.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/atomic.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/binary_queue.cpp
+    ${PROJECT_SOURCE_DIR}/modules/core/src/binary_queue_stream.cpp
+    ${PROJECT_SOURCE_DIR}/modules/core/src/buffer_stream.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/char_traits.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/colors.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/copy.cpp
@@ -38,6 +40,7 @@ SET(DPL_CORE_SOURCES
     ${PROJECT_SOURCE_DIR}/modules/core/src/file_input.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/file_output.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/lexical_cast.cpp
+    ${PROJECT_SOURCE_DIR}/modules/core/src/monotonic_time.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/mutex.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/named_base_pipe.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/named_input_pipe.cpp
@@ -48,9 +51,11 @@ SET(DPL_CORE_SOURCES
     ${PROJECT_SOURCE_DIR}/modules/core/src/recursive_mutex.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/serialization.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/single_instance.cpp
+    ${PROJECT_SOURCE_DIR}/modules/core/src/snapshot.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/singleton.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/semaphore.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/string.cpp
+    ${PROJECT_SOURCE_DIR}/modules/core/src/symbol.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/task.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/task_list.cpp
     ${PROJECT_SOURCE_DIR}/modules/core/src/thread.cpp
@@ -85,7 +90,9 @@ SET(DPL_CORE_HEADERS
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/atomic.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/auto_ptr.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/binary_queue.h
+    ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/binary_queue_stream.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/bool_operator.h
+    ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/buffer_stream.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/char_traits.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/colors.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/copy.h
@@ -98,6 +105,7 @@ SET(DPL_CORE_HEADERS
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/foreach.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/generic_event.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/lexical_cast.h
+    ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/monotonic_time.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/mutex.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/named_base_pipe.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/named_input_pipe.h
@@ -124,14 +132,17 @@ SET(DPL_CORE_HEADERS
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/singleton.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/singleton_impl.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/singleton_safe_impl.h
+    ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/snapshot.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/string.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/sstream.h
+    ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/symbol.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/task.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/task_list.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/thread.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/type_list.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/union_cast.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/unused.h
+    ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/utf8_string.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/workaround.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/zip_input.h
     ${PROJECT_SOURCE_DIR}/modules/core/include/dpl/application.h
@@ -33,7 +33,8 @@ namespace DPL
 /**
  * Binary stream implemented as constant size bucket list
  *
- * @todo Add optimized implementation for FlattenConsume
+ * Copied data is appended to spare room of last copied bucket, so many
+ * small appends share one allocation
  */
 class BinaryQueue
     : public AbstractInputOutput
@@ -75,6 +76,7 @@ private:
         const void *ptr;
         size_t size;
         size_t left;
+        size_t capacity; ///< Bytes allocated, larger than size only for copied data
 
         BufferDeleter deleter;
         void *param;
@@ -89,6 +91,8 @@ private:
 
     static void DeleteBucket(Bucket *bucket);
 
+    size_t AppendToLastBucket(const void *buffer, size_t bufferSize);
+
     class BucketVisitorCall
     {
     private:
@@ -131,6 +135,8 @@ public:
     /**
      * Append copy of @a bufferSize bytes from memory pointed by @a buffer
      * to the end of binary queue. Uses default deleter based on free.
+     * Data is copied to spare room of last bucket when possible, new bucket
+     * is allocated with spare room for next appends.
      *
      * @return none
      * @param[in] buffer Pointer to buffer to copy data from
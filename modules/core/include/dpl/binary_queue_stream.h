@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        binary_queue_stream.h
+ * @version     1.0
+ * @brief       This file is the header file of serialization stream over binary queue
+ */
+#ifndef DPL_BINARY_QUEUE_STREAM_H
+#define DPL_BINARY_QUEUE_STREAM_H
+
+#include <dpl/binary_queue.h>
+#include <dpl/serialization.h>
+#include <dpl/noncopyable.h>
+
+namespace DPL
+{
+/**
+ * Serialization stream writing to the end of binary queue and reading
+ * from its beginning
+ *
+ * Small writes share buckets of binary queue, reads copy data straight
+ * from buckets. Binary queue must outlive the stream.
+ */
+class BinaryQueueStream
+    : public IStream,
+      private Noncopyable
+{
+private:
+    BinaryQueue *m_queue;
+
+public:
+    /**
+     * Constructor
+     *
+     * @param[in] queue Binary queue to read and write
+     */
+    explicit BinaryQueueStream(BinaryQueue *queue);
+
+    /**
+     * Destructor
+     */
+    virtual ~BinaryQueueStream();
+
+    /**
+     * Reads and removes data from beginning of binary queue
+     *
+     * @exception BinaryQueue::Exception::OutOfData Not enough data in queue
+     */
+    virtual void Read(size_t num, void *bytes);
+
+    /**
+     * Appends copy of data to the end of binary queue
+     */
+    virtual void Write(size_t num, const void *bytes);
+};
+} // namespace DPL
+
+#endif // DPL_BINARY_QUEUE_STREAM_H
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        buffer_stream.h
+ * @version     1.0
+ * @brief       This file is the header file of serialization stream over contiguous buffer
+ */
+#ifndef DPL_BUFFER_STREAM_H
+#define DPL_BUFFER_STREAM_H
+
+#include <dpl/serialization.h>
+#include <dpl/exception.h>
+#include <dpl/noncopyable.h>
+#include <vector>
+#include <cstddef>
+
+namespace DPL
+{
+/**
+ * Serialization stream over contiguous memory
+ *
+ * Default constructed stream owns growing buffer: writes append to it,
+ * reads consume from its beginning. Stream constructed over external
+ * buffer reads it in place and cannot be written.
+ */
+class BufferStream
+    : public IStream,
+      private Noncopyable
+{
+public:
+    class Exception
+    {
+    public:
+        DECLARE_EXCEPTION_TYPE(DPL::Exception, Base)
+        DECLARE_EXCEPTION_TYPE(Base, OutOfData)
+        DECLARE_EXCEPTION_TYPE(Base, ReadOnly)
+    };
+
+private:
+    std::vector<unsigned char> m_buffer;
+    const unsigned char *m_data;
+    size_t m_size;
+    size_t m_offset;
+    bool m_readOnly;
+
+public:
+    /**
+     * Construct empty stream owning its buffer
+     */
+    BufferStream();
+
+    /**
+     * Construct read only stream over external buffer, which is not copied
+     * and must outlive the stream
+     *
+     * @param[in] data Pointer to data
+     * @param[in] size Number of bytes in data
+     */
+    BufferStream(const void *data, size_t size);
+
+    /**
+     * Destructor
+     */
+    virtual ~BufferStream();
+
+    /**
+     * Reads and consumes data from current position
+     *
+     * @exception BufferStream::Exception::OutOfData Not enough data left
+     */
+    virtual void Read(size_t num, void *bytes);
+
+    /**
+     * Appends data to the end of owned buffer
+     *
+     * @exception BufferStream::Exception::ReadOnly Stream is over external buffer
+     */
+    virtual void Write(size_t num, const void *bytes);
+
+    /**
+     * Reserve owned buffer for @a size bytes in total
+     */
+    void Reserve(size_t size);
+
+    /**
+     * @return Pointer to data not read yet
+     */
+    const void *Data() const;
+
+    /**
+     * @return Number of bytes not read yet
+     */
+    size_t Size() const;
+};
+} // namespace DPL
+
+#endif // DPL_BUFFER_STREAM_H
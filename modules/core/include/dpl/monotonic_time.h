@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        monotonic_time.h
+ * @version     1.0
+ * @brief       This file is the implementation file of monotonic time
+ */
+#ifndef DPL_MONOTONIC_TIME_H
+#define DPL_MONOTONIC_TIME_H
+
+#include <stdint.h>
+
+namespace DPL
+{
+/**
+ * Get current time of monotonic clock
+ *
+ * Clock is not affected by system time changes, use it to measure
+ * intervals and to schedule delayed work.
+ *
+ * @return Time in microseconds since unspecified starting point
+ */
+uint64_t GetMonotonicTime();
+} // namespace DPL
+
+#endif // DPL_MONOTONIC_TIME_H
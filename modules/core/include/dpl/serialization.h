@@ -26,6 +26,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <type_traits>
 
 namespace DPL {
 
@@ -46,6 +47,15 @@ class ISerializable {
     virtual ~ISerializable(){};
 };
 
+// Types serialized as their raw bytes. Contiguous ranges of them
+// are written and read at once, in the same format as one by one.
+template <typename T>
+struct IsRawSerializable : std::false_type {};
+template <>
+struct IsRawSerializable<int> : std::true_type {};
+template <>
+struct IsRawSerializable<unsigned> : std::true_type {};
+
 struct Serialization {
 // serialization
 // normal functions
@@ -117,6 +127,18 @@ template <typename T>
 static void Serialize(IStream& stream, const std::vector<T>& vec){
     int length = vec.size();
     stream.Write(sizeof(length),&length);
+    SerializeElements(stream, vec, IsRawSerializable<T>());
+}
+template <typename T>
+static void SerializeElements(IStream& stream, const std::vector<T>& vec,
+                              std::true_type){
+    if (!vec.empty()) {
+        stream.Write(vec.size() * sizeof(T), &vec[0]);
+    }
+}
+template <typename T>
+static void SerializeElements(IStream& stream, const std::vector<T>& vec,
+                              std::false_type){
     for(typename std::vector<T>::const_iterator vec_iter = vec.begin();
             vec_iter  != vec.end(); vec_iter ++)
     {
@@ -202,20 +224,14 @@ static void Deserialize(IStream& stream, bool*& value){
 static void Deserialize(IStream& stream, std::string& str){
     int length;
     stream.Read(sizeof(length),&length);
-    char * buf = new char[length+1];
-    stream.Read(length,buf);
-    buf[length] = 0;
-    str = std::string(buf);
-    delete [] buf;
+    str.resize(length);
+    if (length > 0) {
+        stream.Read(length,&str[0]);
+    }
 }
 static void Deserialize(IStream& stream, std::string*& str){
-    int length;
-    stream.Read(sizeof(length),&length);
-    char * buf = new char[length+1];
-    stream.Read(length,buf);
-    buf[length] = 0;
-    str = new std::string(buf);
-    delete [] buf;
+    str = new std::string;
+    Deserialize(stream,*str);
 }
 
 // STL templates
@@ -226,9 +242,9 @@ static void Deserialize(IStream& stream, std::list<T>& list){
     int length;
     stream.Read(sizeof(length),&length);
     for (int i = 0; i < length; ++i) {
-        T obj;
-        Deserialize(stream, obj);
-        list.push_back(obj);
+        // Read in place, without copying the element
+        list.push_back(T());
+        Deserialize(stream, list.back());
     }
 }
 template <typename T>
@@ -242,7 +258,23 @@ template <typename T>
 static void Deserialize(IStream& stream, std::vector<T>& vec){
     int length;
     stream.Read(sizeof(length),&length);
+    if (length > 0) {
+        DeserializeElements(stream, vec, length, IsRawSerializable<T>());
+    }
+}
+template <typename T>
+static void DeserializeElements(IStream& stream, std::vector<T>& vec,
+                                int length, std::true_type){
+    size_t offset = vec.size();
+    vec.resize(offset + length);
+    stream.Read(length * sizeof(T), &vec[offset]);
+}
+template <typename T>
+static void DeserializeElements(IStream& stream, std::vector<T>& vec,
+                                int length, std::false_type){
+    vec.reserve(vec.size() + length);
     for (int i = 0; i < length; ++i) {
+        // Not read in place, std::vector<bool> has no element references
         T obj;
         Deserialize(stream, obj);
         vec.push_back(obj);
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        snapshot.h
+ * @version     1.0
+ * @brief       This file is the header file of offset addressed snapshot format
+ */
+#ifndef DPL_SNAPSHOT_H
+#define DPL_SNAPSHOT_H
+
+#include <dpl/exception.h>
+#include <dpl/noncopyable.h>
+#include <dpl/string.h>
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace DPL
+{
+/*
+ * Snapshot is a position independent buffer which is read in place,
+ * e.g. straight from mapped file, without deserialization.
+ *
+ * Buffer is made of 32-bit words in native byte order. Every object
+ * starts at word boundary and is addressed by its byte offset from
+ * the beginning of the buffer. Offset 0 is the header, so it is used
+ * as "no object" and reads as empty object of any type.
+ *
+ *   header: magic, version, size in bytes, offset of root struct
+ *   string: length, bytes, terminating zero, padding
+ *   vector: count, count words
+ *   struct: count, count words (fields)
+ *   map:    count, count pairs of words (string offset, value),
+ *           sorted by key bytes
+ *
+ * Vector elements, struct fields and map values are single words:
+ * either integers or offsets of other objects. Struct fields missing
+ * at the end read as 0, so newer readers accept older snapshots.
+ */
+typedef uint32_t SnapshotOffset;
+
+class Snapshot;
+
+/**
+ * View of string stored in snapshot
+ */
+class SnapshotString
+{
+private:
+    const char *m_data;
+    size_t m_size;
+
+public:
+    SnapshotString();
+    SnapshotString(const char *data, size_t size);
+
+    /**
+     * @return Zero terminated UTF-8 data, valid while snapshot is alive
+     */
+    const char *c_str() const;
+    size_t size() const;
+    bool empty() const;
+
+    std::string ToStdString() const;
+    String ToString() const;
+
+    bool operator==(const char *other) const;
+    bool operator==(const std::string &other) const;
+};
+
+class SnapshotVector;
+class SnapshotMap;
+
+/**
+ * View of struct stored in snapshot
+ */
+class SnapshotStruct
+{
+private:
+    const Snapshot *m_snapshot;
+    const uint32_t *m_fields;
+    size_t m_count;
+
+public:
+    SnapshotStruct();
+    SnapshotStruct(const Snapshot *snapshot, SnapshotOffset offset);
+
+    size_t FieldCount() const;
+
+    uint32_t GetUnsigned(size_t field) const;
+    int GetInteger(size_t field) const;
+    SnapshotString GetString(size_t field) const;
+    SnapshotStruct GetStruct(size_t field) const;
+    SnapshotVector GetVector(size_t field) const;
+    SnapshotMap GetMap(size_t field) const;
+};
+
+/**
+ * View of vector stored in snapshot
+ */
+class SnapshotVector
+{
+private:
+    const Snapshot *m_snapshot;
+    const uint32_t *m_items;
+    size_t m_count;
+
+public:
+    SnapshotVector();
+    SnapshotVector(const Snapshot *snapshot, SnapshotOffset offset);
+
+    size_t Size() const;
+    bool Empty() const;
+
+    uint32_t GetUnsigned(size_t index) const;
+    int GetInteger(size_t index) const;
+    SnapshotString GetString(size_t index) const;
+    SnapshotStruct GetStruct(size_t index) const;
+    SnapshotVector GetVector(size_t index) const;
+    SnapshotMap GetMap(size_t index) const;
+};
+
+/**
+ * View of string keyed map stored in snapshot. Keys are looked up with
+ * binary search in place.
+ */
+class SnapshotMap
+{
+private:
+    const Snapshot *m_snapshot;
+    const uint32_t *m_pairs;
+    size_t m_count;
+
+    bool FindValue(const char *key, size_t keySize, uint32_t &value) const;
+
+public:
+    SnapshotMap();
+    SnapshotMap(const Snapshot *snapshot, SnapshotOffset offset);
+
+    size_t Size() const;
+    bool Empty() const;
+
+    SnapshotString GetKey(size_t index) const;
+    uint32_t GetValue(size_t index) const;
+
+    /**
+     * @return true when key is found, its value is stored in @a value
+     */
+    bool Find(const std::string &key, uint32_t &value) const;
+
+    /**
+     * @return Struct stored under @a key or empty struct when not found
+     */
+    SnapshotStruct FindStruct(const std::string &key) const;
+
+    /**
+     * @return String stored under @a key or empty string when not found
+     */
+    SnapshotString FindString(const std::string &key) const;
+};
+
+/**
+ * Snapshot reader over memory buffer or mapped file
+ *
+ * Every offset is checked against buffer bounds before it is used,
+ * so damaged file throws Exception::Corrupted instead of crashing.
+ */
+class Snapshot
+    : private Noncopyable
+{
+public:
+    class Exception
+    {
+    public:
+        DECLARE_EXCEPTION_TYPE(DPL::Exception, Base)
+        DECLARE_EXCEPTION_TYPE(Base, OpenFailed)
+        DECLARE_EXCEPTION_TYPE(Base, Corrupted)
+    };
+
+private:
+    const unsigned char *m_data;
+    size_t m_size;
+    void *m_mapping;
+
+    void Verify();
+
+public:
+    /**
+     * Read snapshot from external buffer, which must be aligned to word
+     * and outlive the snapshot
+     */
+    Snapshot(const void *data, size_t size);
+
+    /**
+     * Map snapshot file read only
+     */
+    explicit Snapshot(const std::string &fileName);
+
+    virtual ~Snapshot();
+
+    SnapshotStruct GetRoot() const;
+
+    /**
+     * @return Pointer to @a count words at @a offset, NULL for offset 0
+     * @exception Snapshot::Exception::Corrupted Words are out of buffer
+     */
+    const uint32_t *GetWords(SnapshotOffset offset, size_t count) const;
+
+    SnapshotString GetString(SnapshotOffset offset) const;
+};
+
+/**
+ * Snapshot writer
+ *
+ * Objects are appended in any order, children before parents, and
+ * referenced by returned offsets. Equal strings are stored once.
+ */
+class SnapshotBuilder
+    : private Noncopyable
+{
+public:
+    class Exception
+    {
+    public:
+        DECLARE_EXCEPTION_TYPE(DPL::Exception, Base)
+        DECLARE_EXCEPTION_TYPE(Base, SaveFailed)
+        DECLARE_EXCEPTION_TYPE(Base, TooLarge)
+    };
+
+private:
+    typedef std::map<std::string, SnapshotOffset> StringMap;
+
+    std::vector<uint32_t> m_words;
+    StringMap m_strings;
+
+    SnapshotOffset AppendWords(const uint32_t *words, size_t count);
+
+public:
+    SnapshotBuilder();
+    virtual ~SnapshotBuilder();
+
+    /*
+     * All Add methods throw Exception::TooLarge when size or offset of
+     * added object does not fit into 32-bit word
+     */
+
+    SnapshotOffset AddString(const std::string &string);
+    SnapshotOffset AddString(const String &string);
+
+    /**
+     * @param items Integers or offsets of objects
+     */
+    SnapshotOffset AddVector(const std::vector<uint32_t> &items);
+
+    /**
+     * @param fields Integers or offsets of objects
+     */
+    SnapshotOffset AddStruct(const std::vector<uint32_t> &fields);
+
+    /**
+     * @param map Integers or offsets of objects by key
+     */
+    SnapshotOffset AddMap(const std::map<std::string, uint32_t> &map);
+
+    /**
+     * Set root struct and fill header. Must be called before data is used.
+     */
+    void Finish(SnapshotOffset root);
+
+    const void *GetData() const;
+    size_t GetSize() const;
+
+    /**
+     * Write snapshot to temporary file, sync it and rename it to
+     * @a fileName, so readers never map partially written snapshot
+     */
+    void Save(const std::string &fileName) const;
+};
+} // namespace DPL
+
+#endif // DPL_SNAPSHOT_H
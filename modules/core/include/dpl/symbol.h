@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        symbol.h
+ * @version     1.0
+ * @brief       Interned string handle
+ */
+#ifndef DPL_SYMBOL_H
+#define DPL_SYMBOL_H
+
+#include <dpl/string.h>
+#include <ostream>
+#include <cstddef>
+
+namespace DPL
+{
+// @brief Handle of string kept once in process wide pool
+//
+// Equal strings give the same handle, so comparison and hashing do not
+// look at characters. Pooled strings are never freed; use it for names
+// from a limited set (features, device capabilities, language tags,
+// MIME types), not for arbitrary user data. Thread safe.
+//
+// Order of operator< is stable only during process lifetime. Use
+// LexicalLess where sorted by content output is needed.
+class Symbol
+{
+  public:
+    struct Entry
+    {
+        String value;
+        size_t hash;
+    };
+
+    struct LexicalLess
+    {
+        bool operator()(const Symbol &left, const Symbol &right) const
+        {
+            return left.Get() < right.Get();
+        }
+    };
+
+    // @brief Empty string symbol
+    Symbol();
+
+    explicit Symbol(const String &string);
+
+    const String &Get() const
+    {
+        return m_entry->value;
+    }
+
+    // @brief Returns hash of string, computed once when it was pooled
+    size_t Hash() const
+    {
+        return m_entry->hash;
+    }
+
+    bool empty() const
+    {
+        return m_entry->value.empty();
+    }
+
+    bool operator==(const Symbol &other) const
+    {
+        return m_entry == other.m_entry;
+    }
+
+    bool operator!=(const Symbol &other) const
+    {
+        return m_entry != other.m_entry;
+    }
+
+    bool operator<(const Symbol &other) const
+    {
+        return m_entry < other.m_entry;
+    }
+
+    // @brief Returns number of pooled strings
+    static size_t GetPoolSize();
+
+  private:
+    const Entry *m_entry;
+};
+
+inline std::ostream& operator<<(std::ostream& aStream, const Symbol& aSymbol)
+{
+    return ::operator<<(aStream, aSymbol.Get());
+}
+
+} //namespace DPL
+
+#endif // DPL_SYMBOL_H
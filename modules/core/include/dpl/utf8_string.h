@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        utf8_string.h
+ * @version     1.0
+ * @brief       Compact UTF-8 string storage
+ */
+#ifndef DPL_UTF8_STRING_H
+#define DPL_UTF8_STRING_H
+
+#include <dpl/string.h>
+#include <dpl/optional.h>
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+namespace DPL
+{
+// @brief String kept in UTF-8, as it is stored in database
+//
+// Takes about quarter of DPL::String memory for mostly ASCII text.
+// Conversion to DPL::String is done only when explicitly requested.
+// Comparison is bytewise, which gives the same order as DPL::String.
+class UTF8String
+{
+  public:
+    UTF8String()
+    {
+    }
+
+    // @brief Takes valid UTF-8 data as is
+    explicit UTF8String(const std::string &utf8) :
+        m_string(utf8)
+    {
+    }
+
+    // @brief Takes valid UTF-8 data as is
+    explicit UTF8String(const char *utf8) :
+        m_string(utf8)
+    {
+    }
+
+    explicit UTF8String(const String &string) :
+        m_string(ToUTF8String(string))
+    {
+    }
+
+    // @brief Returns UTF-8 data
+    const std::string &Get() const
+    {
+        return m_string;
+    }
+
+    const char *c_str() const
+    {
+        return m_string.c_str();
+    }
+
+    // @brief Returns size in bytes
+    size_t size() const
+    {
+        return m_string.size();
+    }
+
+    bool empty() const
+    {
+        return m_string.empty();
+    }
+
+    void swap(UTF8String &other)
+    {
+        m_string.swap(other.m_string);
+    }
+
+    String ToString() const
+    {
+        return FromUTF8String(m_string);
+    }
+
+    bool operator==(const UTF8String &other) const
+    {
+        return m_string == other.m_string;
+    }
+
+    bool operator!=(const UTF8String &other) const
+    {
+        return m_string != other.m_string;
+    }
+
+    bool operator<(const UTF8String &other) const
+    {
+        return m_string < other.m_string;
+    }
+
+    bool operator>(const UTF8String &other) const
+    {
+        return m_string > other.m_string;
+    }
+
+    bool operator<=(const UTF8String &other) const
+    {
+        return m_string <= other.m_string;
+    }
+
+    bool operator>=(const UTF8String &other) const
+    {
+        return m_string >= other.m_string;
+    }
+
+  private:
+    std::string m_string;
+};
+
+typedef Optional<UTF8String> OptionalUTF8String;
+
+// Found by argument dependent lookup, also from Optional<UTF8String>
+inline std::ostream& operator<<(std::ostream& aStream,
+                                const UTF8String& aString)
+{
+    return aStream << aString.Get();
+}
+
+} //namespace DPL
+
+#endif // DPL_UTF8_STRING_H
@@ -29,6 +29,13 @@
 
 namespace DPL
 {
+namespace // anonymous
+{
+// Allocation size of buckets for copied data grows up to maximum size
+const size_t MIN_COPY_BUCKET_SIZE = 256;
+const size_t MAX_COPY_BUCKET_SIZE = 64 * 1024;
+} // namespace anonymous
+
 BinaryQueue::BinaryQueue()
     : m_size(0)
 {
@@ -106,10 +113,50 @@ void BinaryQueue::Clear()
     m_size = 0;
 }
 
+size_t BinaryQueue::AppendToLastBucket(const void* buffer, size_t bufferSize)
+{
+    if (m_buckets.empty())
+        return 0;
+
+    Bucket *bucket = m_buckets.back();
+    size_t count = std::min(bufferSize, bucket->capacity - bucket->size);
+
+    if (count == 0)
+        return 0;
+
+    // Spare room is allocated by AppendCopy, so it is writable
+    memcpy(static_cast<char *>(const_cast<void *>(bucket->buffer)) + bucket->size,
+           buffer, count);
+
+    bucket->size += count;
+    bucket->left += count;
+    m_size += count;
+
+    return count;
+}
+
 void BinaryQueue::AppendCopy(const void* buffer, size_t bufferSize)
 {
+    // Fill spare room of last bucket first
+    size_t appended = AppendToLastBucket(buffer, bufferSize);
+
+    buffer = static_cast<const char *>(buffer) + appended;
+    bufferSize -= appended;
+
+    if (bufferSize == 0)
+        return;
+
+    // Next bucket is twice as large as previous one
+    size_t capacity = MIN_COPY_BUCKET_SIZE;
+
+    if (!m_buckets.empty())
+        capacity = std::min(std::max(2 * m_buckets.back()->capacity, capacity),
+                            MAX_COPY_BUCKET_SIZE);
+
+    capacity = std::max(capacity, bufferSize);
+
     // Create data copy with malloc/free
-    void *bufferCopy = malloc(bufferSize);
+    void *bufferCopy = malloc(capacity);
 
     // Check if allocation succeded
     if (bufferCopy == NULL)
@@ -129,6 +176,8 @@ void BinaryQueue::AppendCopy(const void* buffer, size_t bufferSize)
         free(bufferCopy);
         throw;
     }
+
+    m_buckets.back()->capacity = capacity;
 }
 
 void BinaryQueue::AppendUnmanaged(const void* buffer, size_t bufferSize, BufferDeleter deleter, void* userParam)
@@ -218,9 +267,33 @@ void BinaryQueue::Flatten(void *buffer, size_t bufferSize) const
 
 void BinaryQueue::FlattenConsume(void *buffer, size_t bufferSize)
 {
-    // FIXME: Optimize
-    Flatten(buffer, bufferSize);
-    Consume(bufferSize);
+    // Check parameters
+    if (bufferSize > m_size)
+        Throw(Exception::OutOfData);
+
+    size_t bytesLeft = bufferSize;
+    char *ptr = static_cast<char *>(buffer);
+
+    // Copy and consume data in single pass over buckets
+    while (bytesLeft > 0)
+    {
+        Bucket *bucket = m_buckets.front();
+        size_t count = std::min(bytesLeft, bucket->left);
+
+        memcpy(ptr, bucket->ptr, count);
+
+        bucket->ptr = static_cast<const char *>(bucket->ptr) + count;
+        bucket->left -= count;
+        bytesLeft -= count;
+        ptr += count;
+        m_size -= count;
+
+        if (bucket->left == 0)
+        {
+            DeleteBucket(bucket);
+            m_buckets.pop_front();
+        }
+    }
 }
 
 void BinaryQueue::DeleteBucket(BinaryQueue::Bucket *bucket)
@@ -242,6 +315,7 @@ BinaryQueue::Bucket::Bucket(const void* data, size_t dataSize, BufferDeleter dat
       ptr(data),
       size(dataSize),
       left(dataSize),
+      capacity(dataSize),
       deleter(dataDeleter),
       param(userParam)
 {
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        binary_queue_stream.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of serialization stream over binary queue
+ */
+#include <dpl/binary_queue_stream.h>
+#include <dpl/assert.h>
+
+namespace DPL
+{
+BinaryQueueStream::BinaryQueueStream(BinaryQueue *queue)
+    : m_queue(queue)
+{
+    Assert(queue != NULL);
+}
+
+BinaryQueueStream::~BinaryQueueStream()
+{
+}
+
+void BinaryQueueStream::Read(size_t num, void *bytes)
+{
+    m_queue->FlattenConsume(bytes, num);
+}
+
+void BinaryQueueStream::Write(size_t num, const void *bytes)
+{
+    m_queue->AppendCopy(bytes, num);
+}
+} // namespace DPL
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        buffer_stream.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of serialization stream over contiguous buffer
+ */
+#include <dpl/buffer_stream.h>
+#include <dpl/assert.h>
+#include <cstring>
+
+namespace DPL
+{
+BufferStream::BufferStream()
+    : m_data(NULL),
+      m_size(0),
+      m_offset(0),
+      m_readOnly(false)
+{
+}
+
+BufferStream::BufferStream(const void *data, size_t size)
+    : m_data(static_cast<const unsigned char *>(data)),
+      m_size(size),
+      m_offset(0),
+      m_readOnly(true)
+{
+    Assert(data != NULL || size == 0);
+}
+
+BufferStream::~BufferStream()
+{
+}
+
+void BufferStream::Read(size_t num, void *bytes)
+{
+    if (num > m_size - m_offset)
+        ThrowMsg(Exception::OutOfData, "Unexpected end of buffer");
+
+    if (num == 0)
+        return;
+
+    memcpy(bytes, m_data + m_offset, num);
+    m_offset += num;
+}
+
+void BufferStream::Write(size_t num, const void *bytes)
+{
+    if (m_readOnly)
+        ThrowMsg(Exception::ReadOnly, "Cannot write external buffer");
+
+    if (num == 0)
+        return;
+
+    const unsigned char *begin = static_cast<const unsigned char *>(bytes);
+    m_buffer.insert(m_buffer.end(), begin, begin + num);
+
+    // Insert may reallocate buffer
+    m_data = &m_buffer[0];
+    m_size = m_buffer.size();
+}
+
+void BufferStream::Reserve(size_t size)
+{
+    if (m_readOnly)
+        ThrowMsg(Exception::ReadOnly, "Cannot write external buffer");
+
+    m_buffer.reserve(size);
+
+    if (!m_buffer.empty())
+        m_data = &m_buffer[0];
+}
+
+const void *BufferStream::Data() const
+{
+    return m_data + m_offset;
+}
+
+size_t BufferStream::Size() const
+{
+    return m_size - m_offset;
+}
+} // namespace DPL
@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        snapshot.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of offset addressed snapshot format
+ */
+#include <dpl/snapshot.h>
+#include <dpl/scoped_close.h>
+#include <dpl/errno_string.h>
+#include <dpl/foreach.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
+namespace DPL
+{
+namespace // anonymous
+{
+const uint32_t SNAPSHOT_MAGIC = 0x534c5044; // "DPLS" in little endian
+const uint32_t SNAPSHOT_VERSION = 1;
+
+enum HeaderWord
+{
+    HEADER_MAGIC,
+    HEADER_VERSION,
+    HEADER_SIZE,
+    HEADER_ROOT,
+    HEADER_WORDS
+};
+
+const size_t WORD_SIZE = sizeof(uint32_t);
+
+// Length word, bytes and terminating zero, rounded up to words
+size_t StringWords(size_t length)
+{
+    return 1 + (length + 1 + WORD_SIZE - 1) / WORD_SIZE;
+}
+
+// Sizes and offsets are stored in 32-bit words
+uint32_t ToWord(size_t value)
+{
+    if (value > std::numeric_limits<uint32_t>::max())
+        ThrowMsg(SnapshotBuilder::Exception::TooLarge,
+                 "Value " << value << " does not fit into snapshot word");
+
+    return static_cast<uint32_t>(value);
+}
+} // namespace anonymous
+
+SnapshotString::SnapshotString()
+    : m_data(""),
+      m_size(0)
+{
+}
+
+SnapshotString::SnapshotString(const char *data, size_t size)
+    : m_data(data),
+      m_size(size)
+{
+}
+
+const char *SnapshotString::c_str() const
+{
+    return m_data;
+}
+
+size_t SnapshotString::size() const
+{
+    return m_size;
+}
+
+bool SnapshotString::empty() const
+{
+    return m_size == 0;
+}
+
+std::string SnapshotString::ToStdString() const
+{
+    return std::string(m_data, m_size);
+}
+
+String SnapshotString::ToString() const
+{
+    return FromUTF8String(ToStdString());
+}
+
+bool SnapshotString::operator==(const char *other) const
+{
+    return strlen(other) == m_size && memcmp(m_data, other, m_size) == 0;
+}
+
+bool SnapshotString::operator==(const std::string &other) const
+{
+    return other.size() == m_size && memcmp(m_data, other.data(), m_size) == 0;
+}
+
+SnapshotStruct::SnapshotStruct()
+    : m_snapshot(NULL),
+      m_fields(NULL),
+      m_count(0)
+{
+}
+
+SnapshotStruct::SnapshotStruct(const Snapshot *snapshot, SnapshotOffset offset)
+    : m_snapshot(snapshot),
+      m_fields(NULL),
+      m_count(0)
+{
+    if (offset == 0)
+        return;
+
+    m_count = *snapshot->GetWords(offset, 1);
+    m_fields = snapshot->GetWords(offset + WORD_SIZE, m_count);
+}
+
+size_t SnapshotStruct::FieldCount() const
+{
+    return m_count;
+}
+
+uint32_t SnapshotStruct::GetUnsigned(size_t field) const
+{
+    // Fields added after snapshot was written read as 0
+    return field < m_count ? m_fields[field] : 0;
+}
+
+int SnapshotStruct::GetInteger(size_t field) const
+{
+    return static_cast<int>(GetUnsigned(field));
+}
+
+SnapshotString SnapshotStruct::GetString(size_t field) const
+{
+    // Empty struct has no snapshot
+    if (GetUnsigned(field) == 0)
+        return SnapshotString();
+
+    return m_snapshot->GetString(GetUnsigned(field));
+}
+
+SnapshotStruct SnapshotStruct::GetStruct(size_t field) const
+{
+    if (GetUnsigned(field) == 0)
+        return SnapshotStruct();
+
+    return SnapshotStruct(m_snapshot, GetUnsigned(field));
+}
+
+SnapshotVector SnapshotStruct::GetVector(size_t field) const
+{
+    if (GetUnsigned(field) == 0)
+        return SnapshotVector();
+
+    return SnapshotVector(m_snapshot, GetUnsigned(field));
+}
+
+SnapshotMap SnapshotStruct::GetMap(size_t field) const
+{
+    if (GetUnsigned(field) == 0)
+        return SnapshotMap();
+
+    return SnapshotMap(m_snapshot, GetUnsigned(field));
+}
+
+SnapshotVector::SnapshotVector()
+    : m_snapshot(NULL),
+      m_items(NULL),
+      m_count(0)
+{
+}
+
+SnapshotVector::SnapshotVector(const Snapshot *snapshot, SnapshotOffset offset)
+    : m_snapshot(snapshot),
+      m_items(NULL),
+      m_count(0)
+{
+    if (offset == 0)
+        return;
+
+    m_count = *snapshot->GetWords(offset, 1);
+    m_items = snapshot->GetWords(offset + WORD_SIZE, m_count);
+}
+
+size_t SnapshotVector::Size() const
+{
+    return m_count;
+}
+
+bool SnapshotVector::Empty() const
+{
+    return m_count == 0;
+}
+
+uint32_t SnapshotVector::GetUnsigned(size_t index) const
+{
+    if (index >= m_count)
+        ThrowMsg(Snapshot::Exception::Corrupted, "Vector index out of range");
+
+    return m_items[index];
+}
+
+int SnapshotVector::GetInteger(size_t index) const
+{
+    return static_cast<int>(GetUnsigned(index));
+}
+
+SnapshotString SnapshotVector::GetString(size_t index) const
+{
+    return m_snapshot->GetString(GetUnsigned(index));
+}
+
+SnapshotStruct SnapshotVector::GetStruct(size_t index) const
+{
+    return SnapshotStruct(m_snapshot, GetUnsigned(index));
+}
+
+SnapshotVector SnapshotVector::GetVector(size_t index) const
+{
+    return SnapshotVector(m_snapshot, GetUnsigned(index));
+}
+
+SnapshotMap SnapshotVector::GetMap(size_t index) const
+{
+    return SnapshotMap(m_snapshot, GetUnsigned(index));
+}
+
+SnapshotMap::SnapshotMap()
+    : m_snapshot(NULL),
+      m_pairs(NULL),
+      m_count(0)
+{
+}
+
+SnapshotMap::SnapshotMap(const Snapshot *snapshot, SnapshotOffset offset)
+    : m_snapshot(snapshot),
+      m_pairs(NULL),
+      m_count(0)
+{
+    if (offset == 0)
+        return;
+
+    m_count = *snapshot->GetWords(offset, 1);
+    m_pairs = snapshot->GetWords(offset + WORD_SIZE, 2 * m_count);
+}
+
+size_t SnapshotMap::Size() const
+{
+    return m_count;
+}
+
+bool SnapshotMap::Empty() const
+{
+    return m_count == 0;
+}
+
+SnapshotString SnapshotMap::GetKey(size_t index) const
+{
+    if (index >= m_count)
+        ThrowMsg(Snapshot::Exception::Corrupted, "Map index out of range");
+
+    return m_snapshot->GetString(m_pairs[2 * index]);
+}
+
+uint32_t SnapshotMap::GetValue(size_t index) const
+{
+    if (index >= m_count)
+        ThrowMsg(Snapshot::Exception::Corrupted, "Map index out of range");
+
+    return m_pairs[2 * index + 1];
+}
+
+bool SnapshotMap::FindValue(const char *key,
+                            size_t keySize,
+                            uint32_t &value) const
+{
+    size_t begin = 0;
+    size_t end = m_count;
+
+    while (begin < end)
+    {
+        size_t middle = begin + (end - begin) / 2;
+        SnapshotString middleKey = m_snapshot->GetString(m_pairs[2 * middle]);
+
+        // Same order as std::string used by builder
+        int result = memcmp(middleKey.c_str(), key,
+                            std::min(middleKey.size(), keySize));
+
+        if (result == 0)
+        {
+            if (middleKey.size() == keySize)
+            {
+                value = m_pairs[2 * middle + 1];
+                return true;
+            }
+
+            result = middleKey.size() < keySize ? -1 : 1;
+        }
+
+        if (result < 0)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+
+    return false;
+}
+
+bool SnapshotMap::Find(const std::string &key, uint32_t &value) const
+{
+    return FindValue(key.data(), key.size(), value);
+}
+
+SnapshotStruct SnapshotMap::FindStruct(const std::string &key) const
+{
+    uint32_t value;
+
+    if (!Find(key, value))
+        return SnapshotStruct();
+
+    return SnapshotStruct(m_snapshot, value);
+}
+
+SnapshotString SnapshotMap::FindString(const std::string &key) const
+{
+    uint32_t value;
+
+    if (!Find(key, value))
+        return SnapshotString();
+
+    return m_snapshot->GetString(value);
+}
+
+Snapshot::Snapshot(const void *data, size_t size)
+    : m_data(static_cast<const unsigned char *>(data)),
+      m_size(size),
+      m_mapping(NULL)
+{
+    Verify();
+}
+
+Snapshot::Snapshot(const std::string &fileName)
+    : m_data(NULL),
+      m_size(0),
+      m_mapping(NULL)
+{
+    int file = static_cast<int>(
+        TEMP_FAILURE_RETRY(open(fileName.c_str(), O_RDONLY)));
+
+    if (file == -1)
+        ThrowMsg(Exception::OpenFailed,
+                 "Failed to open snapshot " << fileName << ": " <<
+                 GetErrnoString());
+
+    // Mapping stays valid after descriptor is closed
+    ScopedClose scopedClose(file);
+
+    struct stat info;
+
+    if (fstat(file, &info) == -1)
+        ThrowMsg(Exception::OpenFailed,
+                 "Failed to stat snapshot " << fileName << ": " <<
+                 GetErrnoString());
+
+    if (info.st_size == 0)
+        ThrowMsg(Exception::Corrupted, "Empty snapshot " << fileName);
+
+    void *address = mmap(NULL, static_cast<size_t>(info.st_size),
+                         PROT_READ, MAP_PRIVATE, file, 0);
+
+    if (address == MAP_FAILED)
+        ThrowMsg(Exception::OpenFailed,
+                 "Failed to map snapshot " << fileName << ": " <<
+                 GetErrnoString());
+
+    m_mapping = address;
+    m_data = static_cast<const unsigned char *>(address);
+    m_size = static_cast<size_t>(info.st_size);
+
+    Try
+    {
+        Verify();
+    }
+    Catch (Exception::Corrupted)
+    {
+        munmap(m_mapping, m_size);
+        ReThrow(Exception::Corrupted);
+    }
+}
+
+Snapshot::~Snapshot()
+{
+    if (m_mapping != NULL)
+        munmap(m_mapping, m_size);
+}
+
+void Snapshot::Verify()
+{
+    if (reinterpret_cast<uintptr_t>(m_data) % WORD_SIZE != 0)
+        ThrowMsg(Exception::Corrupted, "Snapshot buffer is not aligned");
+
+    if (m_size < HEADER_WORDS * WORD_SIZE || m_size % WORD_SIZE != 0)
+        ThrowMsg(Exception::Corrupted, "Invalid snapshot size: " << m_size);
+
+    const uint32_t *header = reinterpret_cast<const uint32_t *>(m_data);
+
+    if (header[HEADER_MAGIC] != SNAPSHOT_MAGIC)
+        ThrowMsg(Exception::Corrupted, "Invalid snapshot magic");
+
+    if (header[HEADER_VERSION] != SNAPSHOT_VERSION)
+        ThrowMsg(Exception::Corrupted,
+                 "Unsupported snapshot version: " << header[HEADER_VERSION]);
+
+    // Truncated or unfinished snapshot
+    if (header[HEADER_SIZE] != m_size)
+        ThrowMsg(Exception::Corrupted, "Snapshot size mismatch");
+}
+
+const uint32_t *Snapshot::GetWords(SnapshotOffset offset, size_t count) const
+{
+    if (offset == 0)
+        return NULL;
+
+    if (offset % WORD_SIZE != 0 ||
+        offset < HEADER_WORDS * WORD_SIZE ||
+        offset > m_size ||
+        count > (m_size - offset) / WORD_SIZE)
+    {
+        ThrowMsg(Exception::Corrupted,
+                 "Snapshot offset out of range: " << offset);
+    }
+
+    return reinterpret_cast<const uint32_t *>(m_data + offset);
+}
+
+SnapshotString Snapshot::GetString(SnapshotOffset offset) const
+{
+    if (offset == 0)
+        return SnapshotString();
+
+    size_t length = *GetWords(offset, 1);
+
+    if (length >= m_size)
+        ThrowMsg(Exception::Corrupted, "Invalid snapshot string length");
+
+    const char *data = reinterpret_cast<const char *>(
+            GetWords(offset, StringWords(length)) + 1);
+
+    if (data[length] != '\0')
+        ThrowMsg(Exception::Corrupted, "Snapshot string is not terminated");
+
+    return SnapshotString(data, length);
+}
+
+SnapshotStruct Snapshot::GetRoot() const
+{
+    const uint32_t *header = reinterpret_cast<const uint32_t *>(m_data);
+    return SnapshotStruct(this, header[HEADER_ROOT]);
+}
+
+SnapshotBuilder::SnapshotBuilder()
+    : m_words(HEADER_WORDS, 0)
+{
+}
+
+SnapshotBuilder::~SnapshotBuilder()
+{
+}
+
+SnapshotOffset SnapshotBuilder::AppendWords(const uint32_t *words, size_t count)
+{
+    SnapshotOffset offset = ToWord(m_words.size() * WORD_SIZE);
+
+    m_words.push_back(ToWord(count));
+    m_words.insert(m_words.end(), words, words + count);
+
+    return offset;
+}
+
+SnapshotOffset SnapshotBuilder::AddString(const std::string &string)
+{
+    StringMap::const_iterator it = m_strings.find(string);
+
+    if (it != m_strings.end())
+        return it->second;
+
+    SnapshotOffset offset = ToWord(m_words.size() * WORD_SIZE);
+    uint32_t size = ToWord(string.size());
+    size_t first = m_words.size();
+
+    // Zeroed words give terminating zero and padding
+    m_words.resize(first + StringWords(string.size()), 0);
+    m_words[first] = size;
+
+    if (!string.empty())
+        memcpy(&m_words[first + 1], string.data(), string.size());
+
+    m_strings.insert(std::make_pair(string, offset));
+    return offset;
+}
+
+SnapshotOffset SnapshotBuilder::AddString(const String &string)
+{
+    return AddString(ToUTF8String(string));
+}
+
+SnapshotOffset SnapshotBuilder::AddVector(const std::vector<uint32_t> &items)
+{
+    return AppendWords(items.empty() ? NULL : &items[0], items.size());
+}
+
+SnapshotOffset SnapshotBuilder::AddStruct(const std::vector<uint32_t> &fields)
+{
+    return AppendWords(fields.empty() ? NULL : &fields[0], fields.size());
+}
+
+SnapshotOffset SnapshotBuilder::AddMap(const std::map<std::string, uint32_t> &map)
+{
+    // Keys are added first, map words must be contiguous
+    std::vector<uint32_t> pairs;
+    pairs.reserve(2 * map.size());
+
+    FOREACH(it, map)
+    {
+        pairs.push_back(AddString(it->first));
+        pairs.push_back(it->second);
+    }
+
+    SnapshotOffset offset = ToWord(m_words.size() * WORD_SIZE);
+
+    m_words.push_back(ToWord(map.size()));
+    m_words.insert(m_words.end(), pairs.begin(), pairs.end());
+
+    return offset;
+}
+
+void SnapshotBuilder::Finish(SnapshotOffset root)
+{
+    m_words[HEADER_MAGIC] = SNAPSHOT_MAGIC;
+    m_words[HEADER_VERSION] = SNAPSHOT_VERSION;
+    m_words[HEADER_SIZE] = ToWord(m_words.size() * WORD_SIZE);
+    m_words[HEADER_ROOT] = root;
+}
+
+const void *SnapshotBuilder::GetData() const
+{
+    return &m_words[0];
+}
+
+size_t SnapshotBuilder::GetSize() const
+{
+    return m_words.size() * WORD_SIZE;
+}
+
+void SnapshotBuilder::Save(const std::string &fileName) const
+{
+    std::string tempFileName = fileName + ".tmp";
+
+    int file = static_cast<int>(
+        TEMP_FAILURE_RETRY(open(tempFileName.c_str(),
+                                O_WRONLY | O_CREAT | O_TRUNC, 0644)));
+
+    if (file == -1)
+        ThrowMsg(Exception::SaveFailed,
+                 "Failed to create " << tempFileName << ": " <<
+                 GetErrnoString());
+
+    const char *data = static_cast<const char *>(GetData());
+    size_t left = GetSize();
+
+    while (left > 0)
+    {
+        ssize_t written = TEMP_FAILURE_RETRY(write(file, data, left));
+
+        if (written == -1)
+        {
+            int error = errno;
+            close(file);
+            unlink(tempFileName.c_str());
+            ThrowMsg(Exception::SaveFailed,
+                     "Failed to write " << tempFileName << ": " <<
+                     GetErrnoString(error));
+        }
+
+        data += written;
+        left -= static_cast<size_t>(written);
+    }
+
+    // Without sync, rename may reach disk before data and crash would
+    // leave empty or partial snapshot under final name
+    if (TEMP_FAILURE_RETRY(fsync(file)) == -1)
+    {
+        int error = errno;
+        close(file);
+        unlink(tempFileName.c_str());
+        ThrowMsg(Exception::SaveFailed,
+                 "Failed to sync " << tempFileName << ": " <<
+                 GetErrnoString(error));
+    }
+
+    if (close(file) == -1 || rename(tempFileName.c_str(), fileName.c_str()) == -1)
+    {
+        int error = errno;
+        unlink(tempFileName.c_str());
+        ThrowMsg(Exception::SaveFailed,
+                 "Failed to save " << fileName << ": " <<
+                 GetErrnoString(error));
+    }
+}
+} // namespace DPL
@@ -21,7 +21,6 @@
  */
 #include <dpl/string.h>
 #include <dpl/char_traits.h>
-#include <dpl/errno_string.h>
 #include <dpl/exception.h>
 #include <dpl/scoped_array.h>
 #include <dpl/log/log.h>
@@ -29,15 +28,28 @@
 #include <vector>
 #include <algorithm>
 #include <cstring>
-#include <errno.h>
-#include <iconv.h>
+#include <cwchar>
+#include <stdint.h>
 #include <unicode/ustring.h>
 
+// Blocks of ASCII characters are converted without per-character checks.
+// wchar_t holds UTF-32 code unit on all supported platforms.
+#if defined(__SSE2__) && __SIZEOF_WCHAR_T__ == 4
+# define DPL_STRING_SSE2
+# include <emmintrin.h>
+#elif (defined(__ARM_NEON__) || defined(__ARM_NEON)) && __SIZEOF_WCHAR_T__ == 4
+# define DPL_STRING_NEON
+# include <arm_neon.h>
+#endif
+
 // TODO: Completely move to ICU
 namespace DPL
 {
 namespace //anonymous
 {
+// Strings of up to quarter of this size are UTF-8 encoded on stack
+const size_t UTF8_STACK_BUFFER_SIZE = 512;
+
 class ASCIIValidator
 {
     const std::string& m_TestedString;
@@ -65,102 +77,394 @@ void ASCIIValidator::operator()(char aCharacter) const
     }
 }
 
-const iconv_t gc_IconvOperError = reinterpret_cast<iconv_t>(-1);
-const size_t gc_IconvConvertError = static_cast<size_t>(-1);
-} // namespace anonymous
+// Widens leading ASCII blocks of input, returns number of converted characters
+size_t WidenASCIIBlocks(const unsigned char *in, size_t size, wchar_t *out)
+{
+    size_t done = 0;
 
-String FromUTF8String(const std::string& aIn)
+#if defined(DPL_STRING_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+
+    while (done + 16 <= size)
+    {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + done));
+
+        if (_mm_movemask_epi8(chunk) != 0)
+            break;
+
+        __m128i low = _mm_unpacklo_epi8(chunk, zero);
+        __m128i high = _mm_unpackhi_epi8(chunk, zero);
+        __m128i *dest = reinterpret_cast<__m128i *>(out + done);
+
+        _mm_storeu_si128(dest, _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(dest + 1, _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(dest + 2, _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(dest + 3, _mm_unpackhi_epi16(high, zero));
+        done += 16;
+    }
+#elif defined(DPL_STRING_NEON)
+    while (done + 16 <= size)
+    {
+        uint8x16_t chunk = vld1q_u8(in + done);
+        uint8x8_t any = vorr_u8(vget_low_u8(chunk), vget_high_u8(chunk));
+
+        if (vget_lane_u64(vreinterpret_u64_u8(any), 0) &
+            0x8080808080808080ULL)
+            break;
+
+        uint16x8_t low = vmovl_u8(vget_low_u8(chunk));
+        uint16x8_t high = vmovl_u8(vget_high_u8(chunk));
+        uint32_t *dest = reinterpret_cast<uint32_t *>(out + done);
+
+        vst1q_u32(dest, vmovl_u16(vget_low_u16(low)));
+        vst1q_u32(dest + 4, vmovl_u16(vget_high_u16(low)));
+        vst1q_u32(dest + 8, vmovl_u16(vget_low_u16(high)));
+        vst1q_u32(dest + 12, vmovl_u16(vget_high_u16(high)));
+        done += 16;
+    }
+#else
+    while (done + 8 <= size)
+    {
+        uint64_t chunk;
+        memcpy(&chunk, in + done, sizeof(chunk));
+
+        if (chunk & 0x8080808080808080ULL)
+            break;
+
+        for (size_t i = 0; i < 8; ++i)
+            out[done + i] = static_cast<wchar_t>(in[done + i]);
+
+        done += 8;
+    }
+#endif
+
+    return done;
+}
+
+// Narrows leading ASCII blocks of input, returns number of converted characters
+size_t NarrowASCIIBlocks(const wchar_t *in, size_t size, char *out)
 {
-    if (aIn.empty())
+    size_t done = 0;
 
-        return String();
+#if defined(DPL_STRING_SSE2)
+    const __m128i nonASCII = _mm_set1_epi32(~0x7F);
+    const __m128i zero = _mm_setzero_si128();
 
-    size_t inbytes = aIn.size();
+    while (done + 16 <= size)
+    {
+        const __m128i *src = reinterpret_cast<const __m128i *>(in + done);
+        __m128i a = _mm_loadu_si128(src);
+        __m128i b = _mm_loadu_si128(src + 1);
+        __m128i c = _mm_loadu_si128(src + 2);
+        __m128i d = _mm_loadu_si128(src + 3);
+        __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, nonASCII),
+                                              zero)) != 0xFFFF)
+            break;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + done),
+                         _mm_packus_epi16(_mm_packs_epi32(a, b),
+                                          _mm_packs_epi32(c, d)));
+        done += 16;
+    }
+#elif defined(DPL_STRING_NEON)
+    while (done + 16 <= size)
+    {
+        const uint32_t *src = reinterpret_cast<const uint32_t *>(in + done);
+        uint32x4_t a = vld1q_u32(src);
+        uint32x4_t b = vld1q_u32(src + 4);
+        uint32x4_t c = vld1q_u32(src + 8);
+        uint32x4_t d = vld1q_u32(src + 12);
+        uint32x4_t any = vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d));
+        uint32x2_t half = vorr_u32(vget_low_u32(any), vget_high_u32(any));
+
+        if (vget_lane_u64(vreinterpret_u64_u32(half), 0) &
+            0xFFFFFF80FFFFFF80ULL)
+            break;
+
+        uint16x8_t low = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+        uint16x8_t high = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+        uint8_t *dest = reinterpret_cast<uint8_t *>(out + done);
+
+        vst1_u8(dest, vmovn_u16(low));
+        vst1_u8(dest + 8, vmovn_u16(high));
+        done += 16;
+    }
+#else
+    while (done < size &&
+           static_cast<uint32_t>(in[done]) < 0x80)
+    {
+        out[done] = static_cast<char>(in[done]);
+        ++done;
+    }
+#endif
 
-    // Default iconv UTF-32 module adds BOM (4 bytes) in from of string
-    // The worst case is when 8bit UTF-8 char converts to 32bit UTF-32
-    // newsize = oldsize * 4 + end + bom
-    // newsize - bytes for UTF-32 string
-    // oldsize - letters in UTF-8 string
-    // end - end character for UTF-32 (\0)
-    // bom - Unicode header in front of string (0xfeff)
-    size_t outbytes = sizeof(wchar_t)*(inbytes + 2);
-    std::vector<wchar_t> output(inbytes + 2, 0);
+    return done;
+}
 
-    size_t outbytesleft = outbytes;
-    char* inbuf = const_cast<char*>(aIn.c_str());
+// Decodes one well-formed UTF-8 sequence (Unicode Table 3-7).
+// Overlong forms, surrogates and values above U+10FFFF are rejected.
+bool DecodeUTF8(const unsigned char *&in,
+                const unsigned char *end,
+                wchar_t &out)
+{
+    unsigned int lead = *in;
 
-    // vector is used to provide buffer for iconv which expects char* buffer
-    // but during conversion from UTF32 uses internaly wchar_t
-    char* outbuf = reinterpret_cast<char*>(&output[0]);
+    if (lead < 0x80)
+    {
+        out = static_cast<wchar_t>(lead);
+        ++in;
+        return true;
+    }
 
-    iconv_t iconvHandle = iconv_open("UTF-32","UTF-8");
+    size_t length;
+    unsigned int codePoint;
+    unsigned int min = 0x80;
+    unsigned int max = 0xBF;
 
-    if (gc_IconvOperError == iconvHandle)
+    if (lead < 0xC2)
+        return false;
+    else if (lead < 0xE0)
     {
-        int error = errno;
+        length = 2;
+        codePoint = lead & 0x1F;
+    }
+    else if (lead < 0xF0)
+    {
+        length = 3;
+        codePoint = lead & 0x0F;
+
+        if (lead == 0xE0)
+            min = 0xA0;
+        else if (lead == 0xED)
+            max = 0x9F;
+    }
+    else if (lead < 0xF5)
+    {
+        length = 4;
+        codePoint = lead & 0x07;
 
-        ThrowMsg(StringException::IconvInitErrorUTF8ToUTF32,
-                 "iconv_open failed for " << "UTF-32 <- UTF-8" <<
-                 "error: " << GetErrnoString(error));
+        if (lead == 0xF0)
+            min = 0x90;
+        else if (lead == 0xF4)
+            max = 0x8F;
     }
+    else
+        return false;
 
-    size_t iconvRet = iconv(iconvHandle, &inbuf, &inbytes, &outbuf, &outbytesleft);
+    if (static_cast<size_t>(end - in) < length)
+        return false;
 
-    iconv_close(iconvHandle);
+    // Only second byte has narrowed range
+    if (in[1] < min || in[1] > max)
+        return false;
 
-    if (gc_IconvConvertError == iconvRet)
+    for (size_t i = 1; i < length; ++i)
     {
-        ThrowMsg(StringException::IconvConvertErrorUTF8ToUTF32,
-                 "iconv failed for " << "UTF-32 <- UTF-8" << "error: "
-                            << GetErrnoString());
-        return String();
+        if ((in[i] & 0xC0) != 0x80)
+            return false;
+
+        codePoint = (codePoint << 6) | (in[i] & 0x3F);
     }
 
-    // Ignore BOM in front of UTF-32
-    return &output[1];
+    in += length;
+    out = static_cast<wchar_t>(codePoint);
+    return true;
 }
 
-std::string ToUTF8String(const DPL::String& aIn)
+// Returns number of characters written, throws on invalid input
+size_t DecodeUTF8String(const unsigned char *begin,
+                        const unsigned char *end,
+                        wchar_t *out)
 {
-    if (aIn.empty())
+    const unsigned char *in = begin;
+    wchar_t *dest = out;
 
-        return std::string();
+    while (in != end)
+    {
+        size_t ascii = WidenASCIIBlocks(in, end - in, dest);
+        in += ascii;
+        dest += ascii;
+
+        while (in != end && *in < 0x80)
+            *dest++ = static_cast<wchar_t>(*in++);
 
-    size_t inbytes = aIn.size() * sizeof(wchar_t);
-    size_t outbytes = inbytes + sizeof(char);
+        if (in == end)
+            break;
 
-    // wstring returns wchar_t but iconv expects char*
-    // iconv internally is processing input as wchar_t
-    char* inbuf =  reinterpret_cast<char*>(const_cast<wchar_t*>(aIn.c_str()));
-    std::vector<char> output(inbytes, 0);
-    char* outbuf = &output[0];
+        if (!DecodeUTF8(in, end, *dest))
+        {
+            ThrowMsg(StringException::IconvConvertErrorUTF8ToUTF32,
+                     "invalid UTF-8 sequence at offset " << (in - begin));
+        }
 
-    size_t outbytesleft = outbytes;
+        ++dest;
+    }
 
-    iconv_t iconvHandle = iconv_open("UTF-8","UTF-32");
+    return dest - out;
+}
 
-    if (gc_IconvOperError == iconvHandle)
+// Returns number of bytes needed to encode input, throws on invalid input
+size_t EncodedUTF8Length(const wchar_t *begin,
+                         const wchar_t *end)
+{
+    size_t length = 0;
+
+    for (const wchar_t *in = begin; in != end; ++in)
     {
-        ThrowMsg(StringException::IconvInitErrorUTF32ToUTF8,
-                 "iconv_open failed for " << "UTF-8 <- UTF-32"
-                            << "error: " << GetErrnoString());
-        return std::string();
+        uint32_t codePoint = static_cast<uint32_t>(*in);
+
+        if (codePoint < 0x80)
+            length += 1;
+        else if (codePoint < 0x800)
+            length += 2;
+        else if (codePoint < 0x10000)
+        {
+            if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+            {
+                ThrowMsg(StringException::IconvConvertErrorUTF32ToUTF8,
+                         "surrogate code point at offset " << (in - begin));
+            }
+
+            length += 3;
+        }
+        else if (codePoint <= 0x10FFFF)
+            length += 4;
+        else
+        {
+            ThrowMsg(StringException::IconvConvertErrorUTF32ToUTF8,
+                     "invalid code point at offset " << (in - begin));
+        }
     }
 
-    size_t iconvRet = iconv(iconvHandle, &inbuf, &inbytes, &outbuf, &outbytesleft);
+    return length;
+}
 
-    iconv_close(iconvHandle);
+// Returns number of bytes written, throws on invalid input.
+// Output has to hold EncodedUTF8Length bytes.
+size_t EncodeUTF8String(const wchar_t *begin,
+                        const wchar_t *end,
+                        char *out)
+{
+    const wchar_t *in = begin;
+    char *dest = out;
 
-    if (gc_IconvConvertError == iconvRet)
+    while (in != end)
     {
-        ThrowMsg(StringException::IconvConvertErrorUTF32ToUTF8,
-                 "iconv failed for " << "UTF-8 <- UTF-32"
-                            << "error: " << GetErrnoString());
+        size_t ascii = NarrowASCIIBlocks(in, end - in, dest);
+        in += ascii;
+        dest += ascii;
+
+        if (in == end)
+            break;
+
+        uint32_t codePoint = static_cast<uint32_t>(*in);
+
+        if (codePoint < 0x80)
+            *dest++ = static_cast<char>(codePoint);
+        else if (codePoint < 0x800)
+        {
+            *dest++ = static_cast<char>(0xC0 | (codePoint >> 6));
+            *dest++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+            {
+                ThrowMsg(StringException::IconvConvertErrorUTF32ToUTF8,
+                         "surrogate code point at offset " << (in - begin));
+            }
+
+            *dest++ = static_cast<char>(0xE0 | (codePoint >> 12));
+            *dest++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            *dest++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint <= 0x10FFFF)
+        {
+            *dest++ = static_cast<char>(0xF0 | (codePoint >> 18));
+            *dest++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            *dest++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            *dest++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            ThrowMsg(StringException::IconvConvertErrorUTF32ToUTF8,
+                     "invalid code point at offset " << (in - begin));
+        }
+
+        ++in;
+    }
+
+    return dest - out;
+}
+} // namespace anonymous
+
+String FromUTF8String(const std::string& aIn)
+{
+    if (aIn.empty())
+
+        return String();
+
+    const unsigned char *begin =
+        reinterpret_cast<const unsigned char *>(aIn.data());
+    const unsigned char *end = begin + aIn.size();
+
+    // Conversion result is C string: it ends at first NUL character,
+    // but whole input has to be valid
+    const unsigned char *nul =
+        static_cast<const unsigned char *>(memchr(begin, 0, aIn.size()));
+
+    if (nul != NULL)
+    {
+        std::vector<wchar_t> rest(end - nul);
+        DecodeUTF8String(nul, end, &rest[0]);
+        end = nul;
+
+        if (begin == end)
+            return String();
+    }
+
+    // UTF-8 character is never shorter than its UTF-32 counterpart
+    String output(end - begin, L'\0');
+    output.resize(DecodeUTF8String(begin, end, &output[0]));
+    return output;
+}
+
+std::string ToUTF8String(const DPL::String& aIn)
+{
+    if (aIn.empty())
+
         return std::string();
+
+    const wchar_t *begin = aIn.data();
+    const wchar_t *end = begin + aIn.size();
+
+    // Conversion result is C string: it ends at first NUL character,
+    // but whole input has to be valid
+    const wchar_t *nul = wmemchr(begin, L'\0', aIn.size());
+
+    if (nul != NULL)
+    {
+        EncodedUTF8Length(nul, end);
+        end = nul;
+
+        if (begin == end)
+            return std::string();
     }
 
-    return &output[0];
+    // Short strings are encoded on stack and copied, longer ones are
+    // measured first. Either way result does not keep 4 bytes per character.
+    if (static_cast<size_t>(end - begin) <= UTF8_STACK_BUFFER_SIZE / 4)
+    {
+        char buffer[UTF8_STACK_BUFFER_SIZE];
+        return std::string(buffer, EncodeUTF8String(begin, end, buffer));
+    }
+
+    std::string output(EncodedUTF8Length(begin, end), '\0');
+    EncodeUTF8String(begin, end, &output[0]);
+    return output;
 }
 
 String FromASCIIString(const std::string& aString)
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        symbol.cpp
+ * @version     1.0
+ * @brief       Interned string handle
+ */
+#include <dpl/symbol.h>
+#include <dpl/read_write_mutex.h>
+#include <deque>
+#include <map>
+
+namespace DPL
+{
+namespace // anonymous
+{
+struct StringPointerLess
+{
+    bool operator()(const String *left, const String *right) const
+    {
+        return *left < *right;
+    }
+};
+
+size_t HashString(const String &string)
+{
+    // FNV-1a
+    size_t hash = 2166136261U;
+
+    for (String::const_iterator it = string.begin(); it != string.end(); ++it)
+    {
+        hash ^= static_cast<size_t>(*it);
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+class SymbolPool
+{
+  private:
+    typedef std::map<const String *, const Symbol::Entry *,
+                     StringPointerLess> Index;
+
+    ReadWriteMutex m_mutex;
+
+    // Deque never moves its elements, so entries live in place until exit
+    std::deque<Symbol::Entry> m_entries;
+    Index m_index;
+
+    const Symbol::Entry *m_emptyEntry;
+
+  public:
+    SymbolPool()
+    {
+        m_emptyEntry = Intern(String());
+    }
+
+    const Symbol::Entry *GetEmptyEntry() const
+    {
+        return m_emptyEntry;
+    }
+
+    const Symbol::Entry *Intern(const String &string)
+    {
+        {
+            ReadWriteMutex::ScopedReadLock lock(&m_mutex);
+
+            Index::const_iterator it = m_index.find(&string);
+
+            if (it != m_index.end())
+                return it->second;
+        }
+
+        ReadWriteMutex::ScopedWriteLock lock(&m_mutex);
+
+        // Somebody could pool it between locks
+        Index::const_iterator it = m_index.find(&string);
+
+        if (it != m_index.end())
+            return it->second;
+
+        Symbol::Entry entry;
+        entry.value = string;
+        entry.hash = HashString(string);
+        m_entries.push_back(entry);
+
+        const Symbol::Entry *pooled = &m_entries.back();
+        m_index.insert(std::make_pair(&pooled->value, pooled));
+        return pooled;
+    }
+
+    size_t GetSize()
+    {
+        ReadWriteMutex::ScopedReadLock lock(&m_mutex);
+        return m_entries.size();
+    }
+};
+
+SymbolPool &GetPool()
+{
+    // Never destroyed, symbols may be used by other static objects
+    static SymbolPool *pool = new SymbolPool();
+    return *pool;
+}
+} // namespace anonymous
+
+Symbol::Symbol() :
+    m_entry(GetPool().GetEmptyEntry())
+{
+}
+
+Symbol::Symbol(const String &string) :
+    m_entry(GetPool().Intern(string))
+{
+}
+
+size_t Symbol::GetPoolSize()
+{
+    return GetPool().GetSize();
+}
+} // namespace DPL
@@ -20,6 +20,8 @@
 #
 
 SET(DPL_DB_SOURCES
+    ${PROJECT_SOURCE_DIR}/modules/db/src/backoff_synchronization_object.cpp
+    ${PROJECT_SOURCE_DIR}/modules/db/src/deferred_writer.cpp
     ${PROJECT_SOURCE_DIR}/modules/db/src/naive_synchronization_object.cpp
     ${PROJECT_SOURCE_DIR}/modules/db/src/orm.cpp
     ${PROJECT_SOURCE_DIR}/modules/db/src/sql_connection.cpp
@@ -29,6 +31,8 @@ SET(DPL_DB_SOURCES
 
 
 SET(DPL_DB_HEADERS
+    ${PROJECT_SOURCE_DIR}/modules/db/include/dpl/db/backoff_synchronization_object.h
+    ${PROJECT_SOURCE_DIR}/modules/db/include/dpl/db/deferred_writer.h
     ${PROJECT_SOURCE_DIR}/modules/db/include/dpl/db/naive_synchronization_object.h
     ${PROJECT_SOURCE_DIR}/modules/db/include/dpl/db/orm_generator.h
     ${PROJECT_SOURCE_DIR}/modules/db/include/dpl/db/orm.h
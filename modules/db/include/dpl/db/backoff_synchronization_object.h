@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        backoff_synchronization_object.h
+ * @version     1.0
+ * @brief       This file is the header file of SQL backoff synchronization object
+ */
+#ifndef DPL_BACKOFF_SYNCHRONIZATION_OBJECT_H
+#define DPL_BACKOFF_SYNCHRONIZATION_OBJECT_H
+
+#include <dpl/db/sql_connection.h>
+#include <stdint.h>
+
+namespace DPL
+{
+namespace DB
+{
+
+/**
+ * Synchronization object with bounded exponential backoff
+ *
+ * Every collision doubles the wait interval, up to the maximal interval,
+ * with random jitter added so that colliding clients do not retry in
+ * lockstep. Waiting thread is woken up early when any other connection
+ * in this process finishes its transaction. When the collision lasts
+ * longer than the deadline, Exception::Timeout is thrown. Without
+ * deadline, the access is retried until the database is free.
+ */
+class BackoffSynchronizationObject
+    : public SqlConnection::SynchronizationObject
+{
+public:
+    class Exception
+    {
+    public:
+        DECLARE_EXCEPTION_TYPE(SqlConnection::Exception::Base, Timeout)
+    };
+
+    /**
+     * Process-wide contention statistics
+     */
+    struct Statistics
+    {
+        uint64_t collisions;        ///< Number of Synchronize calls
+        uint64_t contendedAccesses; ///< Accesses which hit at least one collision
+        uint64_t wakeups;           ///< Waits finished early by local access
+        uint64_t timeouts;          ///< Accesses abandoned after deadline
+        uint64_t totalWaitTime;     ///< Total time spent waiting [us]
+        uint64_t maxWaitTime;       ///< Longest single access wait [us]
+    };
+
+    /**
+     * @param initialInterval First wait interval [ms]
+     * @param maxInterval Maximal wait interval [ms]
+     * @param deadline Time after which contended access fails [ms],
+     *                 zero to retry without limit
+     */
+    explicit BackoffSynchronizationObject(
+            unsigned long initialInterval = 1,
+            unsigned long maxInterval = 50,
+            unsigned long deadline = GetDefaultDeadline());
+
+    // [SqlConnection::SynchronizationObject]
+    virtual void Synchronize();
+    virtual void NotifyAll();
+
+    /**
+     * Get statistics gathered by all backoff synchronization objects
+     */
+    static Statistics GetStatistics();
+
+    /**
+     * Reset statistics gathered by all backoff synchronization objects
+     */
+    static void ResetStatistics();
+
+    /**
+     * Set deadline of objects created afterwards without explicit one,
+     * including those allocated by default for every SqlConnection.
+     * Initial value is one minute.
+     *
+     * @param deadline Time after which contended access fails [ms],
+     *                 zero to retry without limit
+     */
+    static void SetDefaultDeadline(unsigned long deadline);
+
+    /**
+     * Get deadline used by objects created without explicit one
+     *
+     * @return Deadline [ms], zero when access is retried without limit
+     */
+    static unsigned long GetDefaultDeadline();
+
+private:
+    unsigned long m_initialInterval;
+    unsigned long m_maxInterval;
+    unsigned long m_deadline;
+
+    // State of current contended access
+    unsigned long m_interval;
+    uint64_t m_waitStart;
+    unsigned int m_seed;
+};
+
+} // namespace DB
+} // namespace DPL
+
+#endif // DPL_BACKOFF_SYNCHRONIZATION_OBJECT_H
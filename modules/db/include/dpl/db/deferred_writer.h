@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        deferred_writer.h
+ * @version     1.0
+ * @brief       This file is the header file of deferred database writer
+ */
+#ifndef DPL_DEFERRED_WRITER_H
+#define DPL_DEFERRED_WRITER_H
+
+#include <dpl/noncopyable.h>
+#include <dpl/mutex.h>
+
+namespace DPL
+{
+namespace DB
+{
+
+/**
+ * Writer of changes kept in memory and written to database later
+ *
+ * Derived class keeps its changes and writes all of them in Write().
+ * Write is run by writer thread after delay given to Schedule(); it is
+ * scheduled once until it starts, later calls have no effect. Writer
+ * thread is started on first schedule and has its own connection, which
+ * derived class attaches in AttachToThread(). At process exit the thread
+ * is quit and writes what is left.
+ */
+class DeferredWriter
+    : private Noncopyable
+{
+public:
+    /**
+     * @param name Name of written data, used in logs
+     */
+    explicit DeferredWriter(const char *name);
+    virtual ~DeferredWriter();
+
+    /**
+     * Schedule write in writer thread, unless it is already scheduled
+     *
+     * @param delay Time after which write is run [s]
+     */
+    void Schedule(double delay);
+
+protected:
+    // Called in writer thread
+    virtual void AttachToThread() = 0;
+    virtual void DetachFromThread() = 0;
+    virtual void Write() = 0;
+
+private:
+    class WriterThread;
+
+    const char *m_name;
+    Mutex m_mutex;
+    WriterThread *m_thread;
+    bool m_scheduled;
+    DeferredWriter *m_next;
+
+    void RunWrite(const char *reason);
+
+    static void OnWriteTimer(void *event, void *userParam);
+    static void OnWriteTimerDelete(void *event, void *userParam);
+    static void StopAll();
+};
+
+} // namespace DB
+} // namespace DPL
+
+#endif // DPL_DEFERRED_WRITER_H
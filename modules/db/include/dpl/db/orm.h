@@ -30,6 +30,8 @@
 #include <dpl/db/sql_connection.h>
 #include <dpl/db/orm_interface.h>
 #include <dpl/string.h>
+#include <dpl/utf8_string.h>
+#include <dpl/symbol.h>
 #include <dpl/optional.h>
 #include <dpl/shared_ptr.h>
 #include <dpl/type_list.h>
@@ -58,6 +60,7 @@ typedef size_t ColumnIndex;
 typedef size_t ArgumentIndex;
 typedef DPL::Optional<DPL::String> OptionalString;
 typedef DPL::Optional<int> OptionalInteger;
+typedef DPL::Optional<DPL::UTF8String> OptionalUTF8String;
 typedef DPL::DB::SqlConnection::DataCommand DataCommand;
 
 namespace RelationTypes {
@@ -76,6 +79,9 @@ namespace DataCommandUtils {
     void BindArgument(DataCommand *command, ArgumentIndex index, const OptionalInteger& argument);
     void BindArgument(DataCommand *command, ArgumentIndex index, const DPL::String& argument);
     void BindArgument(DataCommand *command, ArgumentIndex index, const OptionalString& argument);
+    void BindArgument(DataCommand *command, ArgumentIndex index, const DPL::UTF8String& argument);
+    void BindArgument(DataCommand *command, ArgumentIndex index, const OptionalUTF8String& argument);
+    void BindArgument(DataCommand *command, ArgumentIndex index, const DPL::Symbol& argument);
 }
 class Expression {
 public:
@@ -765,7 +771,7 @@ protected:
     std::string m_JoinClause;
     bool                       m_distinctResults;
 
-    void Prepare(const char* selectColumnName)
+    void Prepare(const char* selectColumnName, const char* limitClause = NULL)
     {
         if ( !this->m_command )
         {
@@ -785,6 +791,11 @@ protected:
                 this->m_commandString += " ORDER BY " + *m_orderBy;
             }
 
+            if ( limitClause )
+            {
+                this->m_commandString += limitClause;
+            }
+
             this->m_command = TableDefinition::AllocTableDataCommand(
                 this->m_commandString.c_str(),
                 Query<TableDefinition>::m_interface);
@@ -820,6 +831,19 @@ protected:
         return row;
     }
 
+    template<typename ColumnList, typename Expression>
+    void AppendJoinClause(const char* joinType, const Expression& expression)
+    {
+        std::string usedTableNames = TableDefinition::GetName();
+        if (!m_JoinClause.empty())
+            usedTableNames += m_JoinClause;
+
+        this->m_JoinClause += joinType;
+        this->m_JoinClause += JoinUtil<ColumnList>::GetJoinTableName(usedTableNames);
+        this->m_JoinClause += " ON ";
+        this->m_JoinClause += expression.GetString();
+    }
+
 public:
 
     explicit Select(IOrmInterface *interface = NULL) :
@@ -840,14 +864,17 @@ public:
 
     template<typename ColumnList, typename Expression>
     void Join(const Expression& expression) {
-        std::string usedTableNames = TableDefinition::GetName();
-        if (!m_JoinClause.empty())
-            usedTableNames += m_JoinClause;
+        AppendJoinClause<ColumnList>(" JOIN ", expression);
+    }
 
-        this->m_JoinClause += " JOIN ";
-        this->m_JoinClause += JoinUtil<ColumnList>::GetJoinTableName(usedTableNames);
-        this->m_JoinClause += " ON ";
-        this->m_JoinClause += expression.GetString();
+    /**
+     * Join table keeping rows which have no matching row in joined table
+     *
+     * Columns of joined table are NULL for such rows
+     */
+    template<typename ColumnList, typename Expression>
+    void LeftJoin(const Expression& expression) {
+        AppendJoinClause<ColumnList>(" LEFT JOIN ", expression);
     }
 
     template<typename ColumnData>
@@ -880,6 +907,40 @@ public:
         return resultList;
     }
 
+    /**
+     * Reads column as ValueType instead of its declared type
+     *
+     * E.g. DPL::UTF8String for string column, which is not widened, or
+     * DPL::Symbol for repeated names, which are pooled
+     */
+    template<typename ColumnData, typename ValueType>
+    ValueType GetSingleValue()
+    {
+        Prepare(ColumnData::GetColumnName());
+        Bind();
+        this->m_command->Step();
+
+        ValueType result = GetColumn<ValueType>(0);
+
+        this->m_command->Reset();
+        return result;
+    }
+
+    template<typename ColumnData, typename ValueType>
+    std::list<ValueType> GetValueList()
+    {
+        Prepare(ColumnData::GetColumnName());
+        Bind();
+
+        std::list<ValueType> resultList;
+
+        while (this->m_command->Step())
+            resultList.push_back(GetColumn<ValueType>(0));
+
+        this->m_command->Reset();
+        return resultList;
+    }
+
     Row GetSingleRow()
     {
         Prepare("*");
@@ -907,6 +968,38 @@ public:
         return resultList;
     }
 
+    /**
+     * Check whether any row matches query
+     *
+     * Stops at first matching row and decodes no columns
+     */
+    bool Exists()
+    {
+        Prepare("1", " LIMIT 1");
+        Bind();
+
+        bool result = this->m_command->Step();
+
+        this->m_command->Reset();
+        return result;
+    }
+
+    /**
+     * Count rows matching query
+     */
+    size_t Count()
+    {
+        Prepare("COUNT(*)");
+        Bind();
+        this->m_command->Step();
+
+        size_t result =
+            static_cast<size_t>(this->m_command->GetColumnInt64(0));
+
+        this->m_command->Reset();
+        return result;
+    }
+
     template<typename ColumnList, typename CustomRow>
     CustomRow GetCustomSingleRow()
     {
@@ -81,6 +81,8 @@ namespace ORM {
 #define BIGINT      int  //TODO: should be long long?
 #define VARCHAR(x)  DPL::String
 #define TEXT        DPL::String
+#define UTF8_VARCHAR(x) DPL::UTF8String
+#define UTF8_TEXT   DPL::UTF8String
 
 #define SQL(args...)
 #define TABLE_CONSTRAINTS(args...)
@@ -367,6 +369,8 @@ namespace ORM {
 #undef BIGINT
 #undef VARCHAR
 #undef TEXT
+#undef UTF8_VARCHAR
+#undef UTF8_TEXT
 
 #undef SQL
 #undef TABLE_CONSTRAINTS
@@ -30,4 +30,6 @@
 #define CREATE_TABLE_END() CHECK(1) );
 #define DATABASE_START(db_name)
 #define DATABASE_END()
+#define UTF8_VARCHAR(x) VARCHAR(x)
+#define UTF8_TEXT TEXT
 
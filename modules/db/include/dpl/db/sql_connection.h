@@ -32,6 +32,8 @@
 #include <string>
 #include <dpl/assert.h>
 #include <memory>
+#include <vector>
+#include <list>
 #include <stdint.h>
 
 namespace DPL
@@ -71,9 +73,23 @@ public:
         SqlConnection *m_masterConnection;
         sqlite3_stmt *m_stmt;
 
+        // Profiling of current execution, gathered for profiled connection
+        std::string m_statement;
+        std::vector<std::string> m_arguments;
+        uint64_t m_prepareTime;
+        uint64_t m_executionTime;
+        size_t m_stepCount;
+        size_t m_rowCount;
+
         void CheckBindResult(int result);
         void CheckColumnIndex(SqlConnection::ColumnIndex column);
 
+        void StoreArgument(ArgumentIndex position,
+                           const std::string &type,
+                           const std::string &value);
+        void FinishExecution();
+        void LogQueryPlan();
+
         DataCommand(SqlConnection *connection, const char *buffer);
 
         friend class SqlConnection;
@@ -375,7 +391,34 @@ public:
         enum Type
         {
             None      = 1<<0,
-            UseLucene = 1<<1
+            UseLucene = 1<<1,
+            /**
+             * Write-ahead log journal with normal synchronization.
+             * Readers no longer block the writer and vice versa. Only
+             * read-write connection switches the database into WAL mode.
+             */
+            UseWAL    = 1<<2,
+            /**
+             * Memory-mapped I/O for reading database pages
+             */
+            UseMmap   = 1<<3,
+            /**
+             * Temporary tables and indices kept in memory
+             */
+            UseMemoryTempStore = 1<<4,
+            /**
+             * Bigger page cache than sqlite default
+             */
+            UseLargeCache = 1<<5,
+            /**
+             * Gather statement statistics and log slow queries
+             */
+            UseProfiling = 1<<6,
+            /**
+             * Log argument values of slow queries. Arguments may hold
+             * private data, by default only their types are logged.
+             */
+            UseArgumentLogging = 1<<7
         };
 
         enum Option
@@ -393,6 +436,28 @@ public:
     // RowID
     typedef sqlite3_int64 RowID;
 
+    // Database content version
+    typedef int64_t DataVersion;
+
+    /**
+     * Statistics of single SQL statement gathered by profiled connections
+     *
+     * All times are in microseconds
+     */
+    struct StatementStatistics
+    {
+        std::string statement;
+        uint64_t prepareCount;
+        uint64_t prepareTime;
+        uint64_t executionCount;
+        uint64_t executionTime;
+        uint64_t maxExecutionTime;
+        uint64_t stepCount;
+        uint64_t rowCount;
+    };
+
+    typedef std::list<StatementStatistics> StatementStatisticsList;
+
     /**
      * Synchronization object used to synchronize SQL connection
      * to the same database across different threads and processes
@@ -409,6 +474,9 @@ public:
 
         /**
          * Notify all waiting clients that the connection is no longer locked.
+         *
+         * Called after database access when no transaction is open any
+         * more, and after every access which had to synchronize.
          */
         virtual void NotifyAll() = 0;
     };
@@ -418,10 +486,15 @@ protected:
 
     // Options
     bool m_usingLucene;
+    bool m_usingProfiling;
+    bool m_usingArgumentLogging;
 
     // Stored data procedures
     int m_dataCommandsCount;
 
+    // Prepared on first GetDataVersion call, polled by cache revalidation
+    ScopedPtr<DataCommand> m_dataVersionCommand;
+
     // Synchronization object
     ScopedPtr<SynchronizationObject> m_synchronizationObject;
 
@@ -430,6 +503,7 @@ protected:
     virtual void Disconnect();
 
     void TurnOnForeignKeys();
+    void TurnOnOptions(Flag::Type type, Flag::Option flag);
 
     static SynchronizationObject *AllocDefaultSynchronizationObject();
 
@@ -487,6 +561,43 @@ public:
      * @return Row ID
      */
     RowID GetLastInsertRowID() const;
+
+    /**
+     * Get database content version
+     *
+     * Value changes whenever other connection commits to the database,
+     * changes done through this connection are not reflected.
+     * Use it to revalidate data cached from other processes.
+     *
+     * @return Data version or zero if it is not supported by sqlite
+     */
+    DataVersion GetDataVersion();
+
+    /**
+     * Get statistics gathered by all profiled connections in process
+     *
+     * @return Statistics sorted by total execution time, longest first
+     */
+    static StatementStatisticsList GetStatementStatistics();
+
+    /**
+     * Log statistics gathered by all profiled connections in process
+     */
+    static void DumpStatementStatistics();
+
+    /**
+     * Clear statistics gathered by all profiled connections in process
+     */
+    static void ResetStatementStatistics();
+
+    /**
+     * Set execution time above which profiled statement is logged
+     * with its arguments and query plan. Argument values are logged
+     * only by connection opened with Flag::UseArgumentLogging.
+     *
+     * @param threshold Slow query threshold [us]
+     */
+    static void SetSlowQueryThreshold(uint64_t threshold);
 };
 
 } // namespace DB
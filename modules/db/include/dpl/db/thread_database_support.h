@@ -24,9 +24,13 @@
 #define DPL_THREAD_DATABASE_SUPPORT_H
 
 #include <string>
+#include <list>
+#include <map>
 #include <dpl/db/sql_connection.h>
 #include <dpl/db/orm_interface.h>
 #include <dpl/thread.h>
+#include <dpl/mutex.h>
+#include <dpl/foreach.h>
 #include <dpl/assert.h>
 #include <stdint.h>
 
@@ -40,6 +44,9 @@ namespace DB
  *
  * Associate database connection with thread lifecycle
  *
+ * Read-only connections are not closed on detach. Up to pool size of them
+ * is kept open, together with their prepared data commands, and leased
+ * again by threads attaching in read-only mode.
  */
 
 class ThreadDatabaseSupport :
@@ -47,11 +54,32 @@ class ThreadDatabaseSupport :
 {
   private:
     typedef DPL::DB::SqlConnection *SqlConnectionPtr;
+    typedef DPL::DB::SqlConnection::DataCommand DataCommand;
+
+    // Prepared data commands of pooled connection
+    struct StatementCache
+    {
+        typedef std::multimap<std::string, DataCommand *> IdleCommands;
+        typedef std::map<DataCommand *, std::string> LeasedCommands;
+
+        IdleCommands idle;
+        LeasedCommands leased;
+    };
+
+    typedef StatementCache *StatementCachePtr;
+    typedef std::pair<SqlConnectionPtr, StatementCachePtr> PooledConnection;
+    typedef std::list<PooledConnection> ConnectionPool;
+
     typedef DPL::ThreadLocalVariable<SqlConnectionPtr> TLVSqlConnectionPtr;
+    typedef DPL::ThreadLocalVariable<StatementCachePtr> TLVStatementCachePtr;
     typedef DPL::ThreadLocalVariable<size_t> TLVSizeT;
     typedef DPL::ThreadLocalVariable<bool> TLVBool;
 
+    // Maximum number of idle data commands kept per pooled connection
+    static const size_t MAX_CACHED_STATEMENTS = 64;
+
     TLVSqlConnectionPtr m_connection;
+    TLVStatementCachePtr m_statementCache;
     TLVBool m_linger;
     TLVSizeT m_refCounter;
     TLVSizeT m_transactionDepth;
@@ -60,11 +88,20 @@ class ThreadDatabaseSupport :
     std::string m_address;
     DPL::DB::SqlConnection::Flag::Type m_flags;
 
+    ConnectionPool m_pool;
+    size_t m_poolSize;
+    DPL::Mutex m_poolMutex;
+
     TLVSqlConnectionPtr &Connection()
     {
         return m_connection;
     }
 
+    TLVStatementCachePtr &Statements()
+    {
+        return m_statementCache;
+    }
+
     TLVBool &Linger()
     {
         return m_linger;
@@ -90,6 +127,49 @@ class ThreadDatabaseSupport :
         return m_transactionCancel;
     }
 
+    static void DestroyConnection(SqlConnectionPtr connection,
+                                  StatementCachePtr statements)
+    {
+        if (statements != NULL) {
+            Assert(statements->leased.empty());
+
+            FOREACH(it, statements->idle) {
+                delete it->second;
+            }
+
+            delete statements;
+        }
+
+        delete connection;
+    }
+
+    bool LeaseConnection()
+    {
+        DPL::Mutex::ScopedLock lock(&m_poolMutex);
+
+        if (m_pool.empty()) {
+            return false;
+        }
+
+        Connection() = m_pool.front().first;
+        Statements() = m_pool.front().second;
+        m_pool.pop_front();
+        return true;
+    }
+
+    bool ReleaseConnection(SqlConnectionPtr connection,
+                           StatementCachePtr statements)
+    {
+        DPL::Mutex::ScopedLock lock(&m_poolMutex);
+
+        if (m_pool.size() >= m_poolSize) {
+            return false;
+        }
+
+        m_pool.push_front(PooledConnection(connection, statements));
+        return true;
+    }
+
     void CheckedConnectionDelete()
     {
         Assert(!Connection().IsNull());
@@ -99,13 +179,21 @@ class ThreadDatabaseSupport :
             return;
         }
 
-        // Destroy connection
-        LogInfo("Destroying thread database connection: " << m_address);
+        if (*Statements() != NULL &&
+            ReleaseConnection(*Connection(), *Statements()))
+        {
+            LogInfo("Returning thread database connection to pool: " <<
+                    m_address);
+        } else {
+            // Destroy connection
+            LogInfo("Destroying thread database connection: " << m_address);
 
-        delete *Connection();
+            DestroyConnection(*Connection(), *Statements());
+        }
 
         // Blocking destroy
         Connection().GuardValue(false);
+        Statements().GuardValue(false);
         Linger().GuardValue(false);
         RefCounter().GuardValue(false);
         TransactionCancel().GuardValue(false);
@@ -113,6 +201,7 @@ class ThreadDatabaseSupport :
         AttachCount().GuardValue(false);
 
         Connection().Reset();
+        Statements().Reset();
         Linger().Reset();
         RefCounter().Reset();
         TransactionCancel().Reset();
@@ -138,15 +227,52 @@ class ThreadDatabaseSupport :
     }
 
   public:
+    static const size_t DEFAULT_POOL_SIZE = 4;
+
     ThreadDatabaseSupport(const std::string &address,
-                          DPL::DB::SqlConnection::Flag::Type flags) :
+                          DPL::DB::SqlConnection::Flag::Type flags,
+                          size_t poolSize = DEFAULT_POOL_SIZE) :
         m_address(address),
-        m_flags(flags)
+        m_flags(flags),
+        m_poolSize(poolSize)
     {
     }
 
     virtual ~ThreadDatabaseSupport()
     {
+        FOREACH(it, m_pool) {
+            DestroyConnection(it->first, it->second);
+        }
+    }
+
+    /**
+     * Open read-only connections until pool is full
+     *
+     * Lets first read-only attach of worker threads skip opening database
+     */
+    void FillConnectionPool()
+    {
+        for (;;) {
+            {
+                DPL::Mutex::ScopedLock lock(&m_poolMutex);
+
+                if (m_pool.size() >= m_poolSize) {
+                    return;
+                }
+            }
+
+            LogInfo("Opening pooled database connection: " << m_address);
+
+            SqlConnectionPtr connection =
+                new DPL::DB::SqlConnection(m_address.c_str(),
+                                           m_flags,
+                                           DPL::DB::SqlConnection::Flag::RO);
+
+            if (!ReleaseConnection(connection, new StatementCache())) {
+                delete connection;
+                return;
+            }
+        }
     }
 
     void AttachToThread(
@@ -161,10 +287,28 @@ class ThreadDatabaseSupport :
             return;
         }
 
-        // Initialize SQL connection described in traits
-        LogInfo("Attaching thread database connection: " << m_address);
+        if (options == DPL::DB::SqlConnection::Flag::RO && m_poolSize > 0) {
+            if (LeaseConnection()) {
+                LogInfo("Attaching pooled thread database connection: " <<
+                        m_address);
+            } else {
+                LogInfo("Attaching thread database connection: " <<
+                        m_address);
 
-        Connection() = new DPL::DB::SqlConnection(m_address.c_str(), m_flags, options);
+                Connection() = new DPL::DB::SqlConnection(m_address.c_str(),
+                                                          m_flags,
+                                                          options);
+                Statements() = new StatementCache();
+            }
+        } else {
+            // Initialize SQL connection described in traits
+            LogInfo("Attaching thread database connection: " << m_address);
+
+            Connection() = new DPL::DB::SqlConnection(m_address.c_str(),
+                                                      m_flags,
+                                                      options);
+            Statements() = NULL;
+        }
 
         RefCounter() = 0;
 
@@ -176,6 +320,7 @@ class ThreadDatabaseSupport :
 
         // Blocking destroy
         Connection().GuardValue(true);
+        Statements().GuardValue(true);
         Linger().GuardValue(true);
         RefCounter().GuardValue(true);
         TransactionDepth().GuardValue(true);
@@ -224,8 +369,29 @@ class ThreadDatabaseSupport :
         // Add reference
         ++*RefCounter();
 
-        // Create new unmanaged data command
-        return (*Connection())->PrepareDataCommand(statement.c_str()).release();
+        StatementCachePtr statements = *Statements();
+
+        if (statements == NULL) {
+            // Create new unmanaged data command
+            return (*Connection())->PrepareDataCommand(
+                       statement.c_str()).release();
+        }
+
+        // Reuse data command prepared by previous lessee
+        DataCommand *command;
+        StatementCache::IdleCommands::iterator it =
+            statements->idle.find(statement);
+
+        if (it != statements->idle.end()) {
+            command = it->second;
+            statements->idle.erase(it);
+        } else {
+            command = (*Connection())->PrepareDataCommand(
+                          statement.c_str()).release();
+        }
+
+        statements->leased[command] = statement;
+        return command;
     }
 
     void FreeDataCommand(DPL::DB::SqlConnection::DataCommand *command)
@@ -233,8 +399,26 @@ class ThreadDatabaseSupport :
         // Calling thread must support thread database connections
         Assert(!Connection().IsNull());
 
-        // Delete data command
-        delete command;
+        StatementCachePtr statements = *Statements();
+        StatementCache::LeasedCommands::iterator it;
+
+        if (statements != NULL &&
+            (it = statements->leased.find(command)) !=
+            statements->leased.end())
+        {
+            // Keep data command prepared for next lessee
+            if (statements->idle.size() < MAX_CACHED_STATEMENTS) {
+                command->Reset();
+                statements->idle.insert(std::make_pair(it->second, command));
+            } else {
+                delete command;
+            }
+
+            statements->leased.erase(it);
+        } else {
+            // Delete data command
+            delete command;
+        }
 
         // Unreference SQL connection
         --*RefCounter();
@@ -282,6 +466,18 @@ class ThreadDatabaseSupport :
         TransactionUnref();
     }
 
+    /**
+     * Check whether calling thread is inside of transaction begun through
+     * this object. Data read in such transaction may be uncommitted.
+     */
+    bool IsInTransaction()
+    {
+        // Calling thread must support thread database connections
+        Assert(!Connection().IsNull());
+
+        return *TransactionDepth() > 0;
+    }
+
     DPL::DB::SqlConnection::RowID GetLastInsertRowID()
     {
         // Calling thread must support thread database connections
@@ -297,6 +493,14 @@ class ThreadDatabaseSupport :
 
         return (*Connection())->CheckTableExist(name);
     }
+
+    DPL::DB::SqlConnection::DataVersion GetDataVersion()
+    {
+        // Calling thread must support thread database connections
+        Assert(!Connection().IsNull());
+
+        return (*Connection())->GetDataVersion();
+    }
 };
 
 }
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        backoff_synchronization_object.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of SQL backoff synchronization object
+ */
+#include <dpl/db/backoff_synchronization_object.h>
+#include <dpl/noncopyable.h>
+#include <dpl/atomic.h>
+#include <dpl/log/log.h>
+#include <dpl/monotonic_time.h>
+#include <pthread.h>
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+
+namespace DPL
+{
+namespace DB
+{
+namespace // anonymous
+{
+const unsigned long DEFAULT_DEADLINE = 60000;
+
+// Shared by all backoff objects in process: connections of different
+// threads wake each other up when one of them finishes database access
+pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_once_t g_conditionOnce = PTHREAD_ONCE_INIT;
+pthread_cond_t g_condition;
+unsigned long g_generation = 0;
+unsigned long g_defaultDeadline = DEFAULT_DEADLINE;
+// Modified with mutex locked, read without it by uncontended NotifyAll
+Atomic g_waiters(0);
+BackoffSynchronizationObject::Statistics g_statistics = {};
+
+class ScopedLock
+    : private Noncopyable
+{
+public:
+    ScopedLock()
+    {
+        pthread_mutex_lock(&g_mutex);
+    }
+
+    ~ScopedLock()
+    {
+        pthread_mutex_unlock(&g_mutex);
+    }
+};
+
+// Timed waits must not be affected by system time changes
+void InitializeCondition()
+{
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&g_condition, &attributes);
+    pthread_condattr_destroy(&attributes);
+}
+
+timespec GetAbsoluteTimeout(uint64_t delay)
+{
+    timespec result;
+    clock_gettime(CLOCK_MONOTONIC, &result);
+
+    uint64_t nsec = static_cast<uint64_t>(result.tv_nsec) + delay * 1000;
+    result.tv_sec += static_cast<time_t>(nsec / 1000000000);
+    result.tv_nsec = static_cast<long>(nsec % 1000000000);
+    return result;
+}
+} // namespace anonymous
+
+BackoffSynchronizationObject::BackoffSynchronizationObject(
+        unsigned long initialInterval,
+        unsigned long maxInterval,
+        unsigned long deadline)
+    : m_initialInterval(initialInterval > 0 ? initialInterval : 1),
+      m_maxInterval(maxInterval > m_initialInterval ? maxInterval :
+                                                      m_initialInterval),
+      m_deadline(deadline),
+      m_interval(m_initialInterval),
+      m_waitStart(0),
+      m_seed(static_cast<unsigned int>(
+                 reinterpret_cast<uintptr_t>(this) ^ GetMonotonicTime()))
+{
+    pthread_once(&g_conditionOnce, &InitializeCondition);
+}
+
+void BackoffSynchronizationObject::Synchronize()
+{
+    uint64_t now = GetMonotonicTime();
+
+    if (m_waitStart == 0)
+    {
+        m_waitStart = now;
+        m_interval = m_initialInterval;
+
+        ScopedLock lock;
+        ++g_statistics.contendedAccesses;
+    }
+
+    uint64_t elapsed = now - m_waitStart;
+    uint64_t deadline = static_cast<uint64_t>(m_deadline) * 1000;
+
+    if (deadline != 0 && elapsed >= deadline)
+    {
+        m_waitStart = 0;
+
+        {
+            ScopedLock lock;
+            ++g_statistics.timeouts;
+            g_statistics.totalWaitTime += elapsed;
+
+            if (elapsed > g_statistics.maxWaitTime)
+                g_statistics.maxWaitTime = elapsed;
+        }
+
+        LogError("Database is locked for " << elapsed / 1000 << "ms. Giving up");
+        ThrowMsg(Exception::Timeout, "Database busy timeout");
+    }
+
+    // Half of interval is fixed, second half is random jitter
+    uint64_t interval = static_cast<uint64_t>(m_interval) * 1000;
+    uint64_t delay = interval / 2 + rand_r(&m_seed) % (interval / 2 + 1);
+
+    if (deadline != 0 && delay > deadline - elapsed)
+        delay = deadline - elapsed;
+
+    LogPedantic("Backing off for " << delay << "us");
+
+    {
+        ScopedLock lock;
+        ++g_statistics.collisions;
+        ++g_waiters;
+
+        unsigned long generation = g_generation;
+        timespec timeout = GetAbsoluteTimeout(delay);
+        int ret = 0;
+
+        while (generation == g_generation && ret != ETIMEDOUT)
+            ret = pthread_cond_timedwait(&g_condition, &g_mutex, &timeout);
+
+        if (generation != g_generation)
+            ++g_statistics.wakeups;
+
+        --g_waiters;
+    }
+
+    m_interval = m_interval * 2 < m_maxInterval ? m_interval * 2 :
+                                                  m_maxInterval;
+}
+
+void BackoffSynchronizationObject::NotifyAll()
+{
+    // Fast path for accesses without collision when nobody is waiting.
+    // Waiter registering concurrently may miss this notification, but it
+    // only costs it the rest of its backoff interval
+    if (m_waitStart == 0 && static_cast<Atomic::ValueType>(g_waiters) == 0)
+        return;
+
+    uint64_t wait = 0;
+
+    if (m_waitStart != 0)
+    {
+        wait = GetMonotonicTime() - m_waitStart;
+        m_waitStart = 0;
+    }
+
+    ScopedLock lock;
+
+    if (wait > 0)
+    {
+        g_statistics.totalWaitTime += wait;
+
+        if (wait > g_statistics.maxWaitTime)
+            g_statistics.maxWaitTime = wait;
+    }
+
+    // Wake up threads which collided on our access
+    if (static_cast<Atomic::ValueType>(g_waiters) > 0)
+    {
+        ++g_generation;
+        pthread_cond_broadcast(&g_condition);
+    }
+}
+
+BackoffSynchronizationObject::Statistics
+    BackoffSynchronizationObject::GetStatistics()
+{
+    ScopedLock lock;
+    return g_statistics;
+}
+
+void BackoffSynchronizationObject::ResetStatistics()
+{
+    ScopedLock lock;
+    g_statistics = Statistics();
+}
+
+void BackoffSynchronizationObject::SetDefaultDeadline(unsigned long deadline)
+{
+    ScopedLock lock;
+    g_defaultDeadline = deadline;
+}
+
+unsigned long BackoffSynchronizationObject::GetDefaultDeadline()
+{
+    ScopedLock lock;
+    return g_defaultDeadline;
+}
+
+} // namespace DB
+} // namespace DPL
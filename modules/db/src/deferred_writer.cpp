@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        deferred_writer.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of deferred database writer
+ */
+#include <dpl/db/deferred_writer.h>
+#include <dpl/thread.h>
+#include <dpl/log/log.h>
+#include <cstdlib>
+
+namespace DPL
+{
+namespace DB
+{
+namespace // anonymous
+{
+// Writers whose thread was started, quit by exit handler
+Mutex g_writersMutex;
+DeferredWriter *g_writers = NULL;
+bool g_exitHandlerSet = false;
+} // namespace anonymous
+
+class DeferredWriter::WriterThread
+    : public Thread
+{
+private:
+    DeferredWriter *m_writer;
+
+public:
+    explicit WriterThread(DeferredWriter *writer)
+        : m_writer(writer)
+    {
+    }
+
+protected:
+    virtual int ThreadEntry()
+    {
+        m_writer->AttachToThread();
+
+        int result = Exec();
+
+        // Event loop ends in exit handler, changes made since last write
+        // would be lost
+        m_writer->RunWrite("Final");
+        m_writer->DetachFromThread();
+        return result;
+    }
+};
+
+DeferredWriter::DeferredWriter(const char *name)
+    : m_name(name),
+      m_thread(NULL),
+      m_scheduled(false),
+      m_next(NULL)
+{
+}
+
+DeferredWriter::~DeferredWriter()
+{
+    // Writer thread is quit by exit handler, before writer is destroyed.
+    // It is not deleted, as other static objects it uses may be gone.
+}
+
+void DeferredWriter::Schedule(double delay)
+{
+    Mutex::ScopedLock lock(&m_mutex);
+
+    if (m_scheduled)
+        return;
+
+    if (!m_thread)
+    {
+        m_thread = new WriterThread(this);
+        m_thread->Run();
+
+        Mutex::ScopedLock writersLock(&g_writersMutex);
+        m_next = g_writers;
+        g_writers = this;
+
+        if (!g_exitHandlerSet)
+        {
+            atexit(&StopAll);
+            g_exitHandlerSet = true;
+        }
+    }
+
+    m_thread->PushTimedEvent(NULL, delay, &OnWriteTimer,
+                             &OnWriteTimerDelete, this);
+    m_scheduled = true;
+}
+
+void DeferredWriter::RunWrite(const char *reason)
+{
+    // Changes made from now on schedule next write
+    {
+        Mutex::ScopedLock lock(&m_mutex);
+        m_scheduled = false;
+    }
+
+    Try
+    {
+        Write();
+    }
+    Catch(DPL::Exception)
+    {
+        LogError(reason << " write of " << m_name << " failed");
+    }
+}
+
+void DeferredWriter::OnWriteTimer(void *event, void *userParam)
+{
+    (void)event;
+    static_cast<DeferredWriter *>(userParam)->RunWrite("Deferred");
+}
+
+void DeferredWriter::OnWriteTimerDelete(void *event, void *userParam)
+{
+    (void)event;
+    (void)userParam;
+}
+
+void DeferredWriter::StopAll()
+{
+    DeferredWriter *writers;
+
+    // Quit waits for final write, which may schedule and take the lock
+    {
+        Mutex::ScopedLock lock(&g_writersMutex);
+        writers = g_writers;
+    }
+
+    for (DeferredWriter *writer = writers; writer; writer = writer->m_next)
+        writer->m_thread->Quit();
+}
+
+} // namespace DB
+} // namespace DPL
@@ -63,6 +63,32 @@ OptionalString GetColumnFromCommand<OptionalString>(ColumnIndex columnIndex,
     return command->GetColumnOptionalString(columnIndex);
 }
 
+template<>
+DPL::UTF8String GetColumnFromCommand<DPL::UTF8String>(ColumnIndex columnIndex,
+        DataCommand *command)
+{
+    return DPL::UTF8String(command->GetColumnString(columnIndex));
+}
+
+template<>
+OptionalUTF8String GetColumnFromCommand<OptionalUTF8String>(
+        ColumnIndex columnIndex,
+        DataCommand *command)
+{
+    if (command->IsColumnNull(columnIndex))
+        return OptionalUTF8String::Null;
+    return OptionalUTF8String(
+        DPL::UTF8String(command->GetColumnString(columnIndex)));
+}
+
+template<>
+DPL::Symbol GetColumnFromCommand<DPL::Symbol>(ColumnIndex columnIndex,
+        DataCommand *command)
+{
+    return DPL::Symbol(DPL::FromUTF8String(
+        command->GetColumnString(columnIndex)));
+}
+
 template<>
 double GetColumnFromCommand<double>(ColumnIndex columnIndex,
         DataCommand *command)
@@ -98,6 +124,30 @@ void DataCommandUtils::BindArgument(DataCommand *command,
     command->BindString(index, argument);
 }
 
+void DataCommandUtils::BindArgument(DataCommand *command,
+        ArgumentIndex index,
+        const DPL::UTF8String& argument)
+{
+    command->BindString(index, argument.c_str());
+}
+
+void DataCommandUtils::BindArgument(DataCommand *command,
+        ArgumentIndex index,
+        const OptionalUTF8String& argument)
+{
+    if (argument.IsNull())
+        command->BindNull(index);
+    else
+        command->BindString(index, argument->c_str());
+}
+
+void DataCommandUtils::BindArgument(DataCommand *command,
+        ArgumentIndex index,
+        const DPL::Symbol& argument)
+{
+    command->BindString(index, argument.Get());
+}
+
 }
 }
 }
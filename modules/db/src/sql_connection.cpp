@@ -20,14 +20,18 @@
  * @brief       This file is the implementation file of SQL connection
  */
 #include <dpl/db/sql_connection.h>
-#include <dpl/db/naive_synchronization_object.h>
+#include <dpl/db/backoff_synchronization_object.h>
 #include <dpl/scoped_free.h>
 #include <dpl/noncopyable.h>
 #include <dpl/assert.h>
+#include <dpl/mutex.h>
+#include <dpl/monotonic_time.h>
 #include <db-util.h>
 #include <unistd.h>
 #include <cstdio>
 #include <cstdarg>
+#include <map>
+#include <sstream>
 
 namespace DPL
 {
@@ -36,25 +40,88 @@ namespace DB
 
 namespace // anonymous
 {
+// Tuning values used by connection options
+const int MMAP_SIZE_BYTES = 8 * 1024 * 1024;
+const int CACHE_SIZE_KIBIBYTES = 4 * 1024;
+const uint64_t DEFAULT_SLOW_QUERY_THRESHOLD = 50000;
+
+typedef std::map<std::string, SqlConnection::StatementStatistics>
+    StatementStatisticsMap;
+
+// Statistics gathered by all profiled connections
+Mutex g_statisticsMutex;
+StatementStatisticsMap g_statementStatistics;
+uint64_t g_slowQueryThreshold = DEFAULT_SLOW_QUERY_THRESHOLD;
+
+// Must be called with statistics mutex locked
+SqlConnection::StatementStatistics &GetStatistics(const std::string &statement)
+{
+    StatementStatisticsMap::iterator it =
+        g_statementStatistics.find(statement);
+
+    if (it == g_statementStatistics.end())
+    {
+        SqlConnection::StatementStatistics statistics =
+            SqlConnection::StatementStatistics();
+        statistics.statement = statement;
+
+        it = g_statementStatistics.insert(
+                std::make_pair(statement, statistics)).first;
+    }
+
+    return it->second;
+}
+
+bool IsLongerExecution(const SqlConnection::StatementStatistics &first,
+                       const SqlConnection::StatementStatistics &second)
+{
+    return first.executionTime > second.executionTime;
+}
+
+template<typename Type>
+std::string ArgumentString(const Type &value)
+{
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+
 class ScopedNotifyAll
     : public Noncopyable
 {
 private:
     SqlConnection::SynchronizationObject *m_synchronizationObject;
+    sqlite3 *m_connection;
+    bool m_synchronized;
 
 public:
-    explicit ScopedNotifyAll(
-        SqlConnection::SynchronizationObject *synchronizationObject)
-        : m_synchronizationObject(synchronizationObject)
+    ScopedNotifyAll(
+        SqlConnection::SynchronizationObject *synchronizationObject,
+        sqlite3 *connection)
+        : m_synchronizationObject(synchronizationObject),
+          m_connection(connection),
+          m_synchronized(false)
     {
     }
 
+    void Synchronize()
+    {
+        m_synchronized = true;
+        m_synchronizationObject->Synchronize();
+    }
+
     ~ScopedNotifyAll()
     {
         if (!m_synchronizationObject)
             return;
 
-        LogPedantic("Notifying after successful synchronize");
+        // Locks are held until transaction ends, waking up other clients
+        // earlier only makes them collide again. Access which had to
+        // synchronize is always finished, so that it is accounted for.
+        if (!m_synchronized && !sqlite3_get_autocommit(m_connection))
+            return;
+
+        LogPedantic("Notifying after database access");
         m_synchronizationObject->NotifyAll();
     }
 };
@@ -63,12 +130,19 @@ public:
 SqlConnection::DataCommand::DataCommand(SqlConnection *connection,
                                         const char *buffer)
     : m_masterConnection(connection),
-      m_stmt(NULL)
+      m_stmt(NULL),
+      m_prepareTime(0),
+      m_executionTime(0),
+      m_stepCount(0),
+      m_rowCount(0)
 {
     Assert(connection != NULL);
 
     // Notify all after potentially synchronized database connection access
-    ScopedNotifyAll notifyAll(connection->m_synchronizationObject.Get());
+    ScopedNotifyAll notifyAll(connection->m_synchronizationObject.Get(),
+                              connection->m_connection);
+
+    uint64_t start = connection->m_usingProfiling ? GetMonotonicTime() : 0;
 
     for (;;)
     {
@@ -89,7 +163,7 @@ SqlConnection::DataCommand::DataCommand(SqlConnection *connection,
             if (connection->m_synchronizationObject)
             {
                 LogPedantic("Performing synchronization");
-                connection->m_synchronizationObject->Synchronize();
+                notifyAll.Synchronize();
                 continue;
             }
 
@@ -108,6 +182,17 @@ SqlConnection::DataCommand::DataCommand(SqlConnection *connection,
 
     LogPedantic("Prepared data command: " << buffer);
 
+    if (connection->m_usingProfiling)
+    {
+        m_statement = buffer;
+        m_prepareTime = GetMonotonicTime() - start;
+
+        Mutex::ScopedLock lock(&g_statisticsMutex);
+        StatementStatistics &statistics = GetStatistics(m_statement);
+        ++statistics.prepareCount;
+        statistics.prepareTime += m_prepareTime;
+    }
+
     // Increment stored data command count
     ++m_masterConnection->m_dataCommandsCount;
 }
@@ -116,6 +201,8 @@ SqlConnection::DataCommand::~DataCommand()
 {
     LogPedantic("SQL data command finalizing");
 
+    FinishExecution();
+
     if (sqlite3_finalize(m_stmt) != SQLITE_OK)
         LogPedantic("Failed to finalize data command");
 
@@ -137,12 +224,108 @@ void SqlConnection::DataCommand::CheckBindResult(int result)
     }
 }
 
+void SqlConnection::DataCommand::StoreArgument(
+    SqlConnection::ArgumentIndex position,
+    const std::string &type,
+    const std::string &value)
+{
+    if (position < 1)
+        return;
+
+    if (m_arguments.size() < static_cast<size_t>(position))
+        m_arguments.resize(position);
+
+    // Values may be private, log them only when explicitly requested
+    if (m_masterConnection->m_usingArgumentLogging)
+        m_arguments[position - 1] = value;
+    else
+        m_arguments[position - 1] = type;
+}
+
+void SqlConnection::DataCommand::FinishExecution()
+{
+    if (!m_masterConnection->m_usingProfiling || m_stepCount == 0)
+    {
+        m_arguments.clear();
+        return;
+    }
+
+    bool slow;
+
+    {
+        Mutex::ScopedLock lock(&g_statisticsMutex);
+        StatementStatistics &statistics = GetStatistics(m_statement);
+
+        ++statistics.executionCount;
+        statistics.executionTime += m_executionTime;
+        statistics.stepCount += m_stepCount;
+        statistics.rowCount += m_rowCount;
+
+        if (m_executionTime > statistics.maxExecutionTime)
+            statistics.maxExecutionTime = m_executionTime;
+
+        slow = m_executionTime >= g_slowQueryThreshold;
+    }
+
+    if (slow)
+    {
+        LogWarning("Slow SQL statement: " << m_executionTime << "us, "
+                   << m_stepCount << " steps, " << m_rowCount << " rows");
+        LogWarning("    Statement: " << m_statement);
+
+        // Only arguments bound since last reset are known; SQLite keeps
+        // older bindings, but they are not logged
+        for (size_t i = 0; i < m_arguments.size(); ++i)
+        {
+            if (!m_arguments[i].empty())
+                LogWarning("    Argument [" << i + 1 << "]: "
+                           << m_arguments[i]);
+        }
+
+        LogQueryPlan();
+    }
+
+    m_arguments.clear();
+    m_executionTime = 0;
+    m_stepCount = 0;
+    m_rowCount = 0;
+}
+
+void SqlConnection::DataCommand::LogQueryPlan()
+{
+    std::string query = "EXPLAIN QUERY PLAN " + m_statement;
+    sqlite3_stmt *stmt;
+
+    if (sqlite3_prepare_v2(m_masterConnection->m_connection,
+                           query.c_str(), -1, &stmt, NULL) != SQLITE_OK)
+    {
+        LogWarning("    Query plan is not available");
+        return;
+    }
+
+    // Plan description is always the last column
+    int detail = sqlite3_column_count(stmt) - 1;
+
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        const unsigned char *text = sqlite3_column_text(stmt, detail);
+
+        if (text)
+            LogWarning("    Plan: " << reinterpret_cast<const char *>(text));
+    }
+
+    sqlite3_finalize(stmt);
+}
+
 void SqlConnection::DataCommand::BindNull(
     SqlConnection::ArgumentIndex position)
 {
     CheckBindResult(sqlite3_bind_null(m_stmt, position));
     LogPedantic("SQL data command bind null: ["
                 << position << "]");
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position, "NULL", "NULL");
 }
 
 void SqlConnection::DataCommand::BindInteger(
@@ -152,6 +335,9 @@ void SqlConnection::DataCommand::BindInteger(
     CheckBindResult(sqlite3_bind_int(m_stmt, position, value));
     LogPedantic("SQL data command bind integer: ["
                 << position << "] -> " << value);
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position, "integer", ArgumentString(value));
 }
 
 void SqlConnection::DataCommand::BindInt8(
@@ -162,6 +348,10 @@ void SqlConnection::DataCommand::BindInt8(
                                      static_cast<int>(value)));
     LogPedantic("SQL data command bind int8: ["
                 << position << "] -> " << value);
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position, "integer",
+                      ArgumentString(static_cast<int>(value)));
 }
 
 void SqlConnection::DataCommand::BindInt16(
@@ -172,6 +362,9 @@ void SqlConnection::DataCommand::BindInt16(
                                      static_cast<int>(value)));
     LogPedantic("SQL data command bind int16: ["
                 << position << "] -> " << value);
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position, "integer", ArgumentString(value));
 }
 
 void SqlConnection::DataCommand::BindInt32(
@@ -182,6 +375,9 @@ void SqlConnection::DataCommand::BindInt32(
                                      static_cast<int>(value)));
     LogPedantic("SQL data command bind int32: ["
                 << position << "] -> " << value);
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position, "integer", ArgumentString(value));
 }
 
 void SqlConnection::DataCommand::BindInt64(
@@ -192,6 +388,9 @@ void SqlConnection::DataCommand::BindInt64(
                                        static_cast<sqlite3_int64>(value)));
     LogPedantic("SQL data command bind int64: ["
                 << position << "] -> " << value);
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position, "integer", ArgumentString(value));
 }
 
 void SqlConnection::DataCommand::BindFloat(
@@ -202,6 +401,9 @@ void SqlConnection::DataCommand::BindFloat(
                                         static_cast<double>(value)));
     LogPedantic("SQL data command bind float: ["
                 << position << "] -> " << value);
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position, "real", ArgumentString(value));
 }
 
 void SqlConnection::DataCommand::BindDouble(
@@ -211,6 +413,9 @@ void SqlConnection::DataCommand::BindDouble(
     CheckBindResult(sqlite3_bind_double(m_stmt, position, value));
     LogPedantic("SQL data command bind double: ["
                 << position << "] -> " << value);
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position, "real", ArgumentString(value));
 }
 
 void SqlConnection::DataCommand::BindString(
@@ -230,6 +435,11 @@ void SqlConnection::DataCommand::BindString(
 
     LogPedantic("SQL data command bind string: ["
                 << position << "] -> " << value);
+
+    if (m_masterConnection->m_usingProfiling)
+        StoreArgument(position,
+                      "text, " + ArgumentString(strlen(value)) + " bytes",
+                      "'" + std::string(value) + "'");
 }
 
 void SqlConnection::DataCommand::BindString(
@@ -323,12 +533,25 @@ bool SqlConnection::DataCommand::Step()
 {
     // Notify all after potentially synchronized database connection access
     ScopedNotifyAll notifyAll(
-        m_masterConnection->m_synchronizationObject.Get());
+        m_masterConnection->m_synchronizationObject.Get(),
+        m_masterConnection->m_connection);
+
+    bool profiling = m_masterConnection->m_usingProfiling;
+    uint64_t start = profiling ? GetMonotonicTime() : 0;
 
     for (;;)
     {
         int ret = sqlite3_step(m_stmt);
 
+        if (profiling && (ret == SQLITE_ROW || ret == SQLITE_DONE))
+        {
+            m_executionTime += GetMonotonicTime() - start;
+            ++m_stepCount;
+
+            if (ret == SQLITE_ROW)
+                ++m_rowCount;
+        }
+
         if (ret == SQLITE_ROW)
         {
             LogPedantic("SQL data command step ROW");
@@ -348,8 +571,7 @@ bool SqlConnection::DataCommand::Step()
             {
                 LogPedantic("Performing synchronization");
 
-                m_masterConnection->
-                    m_synchronizationObject->Synchronize();
+                notifyAll.Synchronize();
 
                 continue;
             }
@@ -379,6 +601,8 @@ void SqlConnection::DataCommand::Reset()
      */
     sqlite3_reset(m_stmt);
 
+    FinishExecution();
+
     LogPedantic("SQL data command reset");
 }
 
@@ -631,6 +855,12 @@ void SqlConnection::Connect(const std::string &address,
 
     // Enable foreign keys
     TurnOnForeignKeys();
+
+    // Apply requested journaling and I/O options
+    TurnOnOptions(type, flag);
+
+    m_usingProfiling = (type & Flag::UseProfiling) != 0;
+    m_usingArgumentLogging = (type & Flag::UseArgumentLogging) != 0;
 }
 
 void SqlConnection::Disconnect()
@@ -643,6 +873,8 @@ void SqlConnection::Disconnect()
 
     LogPedantic("Disconnecting from DB...");
 
+    m_dataVersionCommand.Reset();
+
     // All stored data commands must be deleted before disconnect
     Assert(m_dataCommandsCount == 0 &&
            "All stored procedures must be deleted"
@@ -700,6 +932,8 @@ SqlConnection::SqlConnection(const std::string &address,
                              SynchronizationObject *synchronizationObject)
     : m_connection(NULL),
       m_usingLucene(false),
+      m_usingProfiling(false),
+      m_usingArgumentLogging(false),
       m_dataCommandsCount(0),
       m_synchronizationObject(synchronizationObject)
 {
@@ -764,7 +998,7 @@ void SqlConnection::ExecCommand(const char *format, ...)
     LogPedantic("Executing SQL command: " << buffer.Get());
 
     // Notify all after potentially synchronized database connection access
-    ScopedNotifyAll notifyAll(m_synchronizationObject.Get());
+    ScopedNotifyAll notifyAll(m_synchronizationObject.Get(), m_connection);
 
     for (;;)
     {
@@ -796,7 +1030,7 @@ void SqlConnection::ExecCommand(const char *format, ...)
             if (m_synchronizationObject)
             {
                 LogPedantic("Performing synchronization");
-                m_synchronizationObject->Synchronize();
+                notifyAll.Synchronize();
                 continue;
             }
 
@@ -847,15 +1081,128 @@ SqlConnection::RowID SqlConnection::GetLastInsertRowID() const
     return static_cast<RowID>(sqlite3_last_insert_rowid(m_connection));
 }
 
+SqlConnection::DataVersion SqlConnection::GetDataVersion()
+{
+    if (m_connection == NULL)
+    {
+        LogPedantic("Cannot get data version. Not connected to DB!");
+        return 0;
+    }
+
+    if (!m_dataVersionCommand)
+    {
+        m_dataVersionCommand.Reset(
+            PrepareDataCommand("PRAGMA data_version;").release());
+    }
+
+    DataVersion version = 0;
+
+    if (m_dataVersionCommand->Step())
+    {
+        version = static_cast<DataVersion>(
+            m_dataVersionCommand->GetColumnInt64(0));
+    }
+    else
+    {
+        LogPedantic("Data version is not supported");
+    }
+
+    m_dataVersionCommand->Reset();
+    return version;
+}
+
 void SqlConnection::TurnOnForeignKeys()
 {
     ExecCommand("PRAGMA foreign_keys = ON;");
 }
 
+void SqlConnection::TurnOnOptions(Flag::Type type, Flag::Option flag)
+{
+    if (type & Flag::UseWAL) {
+        // Journal mode is persistent and only a read-write connection can
+        // switch it. Read-only connection uses whatever mode is set.
+        if (flag & SQLITE_OPEN_READONLY) {
+            LogPedantic("Write-ahead log left to read-write connection");
+        } else {
+            ExecCommand("PRAGMA journal_mode = WAL;");
+            ExecCommand("PRAGMA synchronous = NORMAL;");
+            LogPedantic("Write-ahead log enabled");
+        }
+    }
+
+    if (type & Flag::UseMmap) {
+        ExecCommand("PRAGMA mmap_size = %i;", MMAP_SIZE_BYTES);
+        LogPedantic("Memory-mapped I/O enabled");
+    }
+
+    if (type & Flag::UseMemoryTempStore) {
+        ExecCommand("PRAGMA temp_store = MEMORY;");
+        LogPedantic("Memory temporary store enabled");
+    }
+
+    if (type & Flag::UseLargeCache) {
+        // Negative value is cache size in kibibytes, not in pages
+        ExecCommand("PRAGMA cache_size = -%i;", CACHE_SIZE_KIBIBYTES);
+        LogPedantic("Large page cache enabled");
+    }
+}
+
 SqlConnection::SynchronizationObject *
     SqlConnection::AllocDefaultSynchronizationObject()
 {
-    return new NaiveSynchronizationObject();
+    return new BackoffSynchronizationObject();
+}
+
+SqlConnection::StatementStatisticsList SqlConnection::GetStatementStatistics()
+{
+    StatementStatisticsList result;
+
+    {
+        Mutex::ScopedLock lock(&g_statisticsMutex);
+
+        for (StatementStatisticsMap::const_iterator it =
+                 g_statementStatistics.begin();
+             it != g_statementStatistics.end();
+             ++it)
+        {
+            result.push_back(it->second);
+        }
+    }
+
+    result.sort(IsLongerExecution);
+    return result;
+}
+
+void SqlConnection::DumpStatementStatistics()
+{
+    StatementStatisticsList statistics = GetStatementStatistics();
+
+    LogInfo("SQL statement statistics (" << statistics.size()
+            << " statements)");
+
+    for (StatementStatisticsList::const_iterator it = statistics.begin();
+         it != statistics.end();
+         ++it)
+    {
+        LogInfo("    " << it->statement);
+        LogInfo("        prepared " << it->prepareCount << "x in "
+                << it->prepareTime << "us, executed "
+                << it->executionCount << "x in " << it->executionTime
+                << "us (max " << it->maxExecutionTime << "us), "
+                << it->stepCount << " steps, " << it->rowCount << " rows");
+    }
+}
+
+void SqlConnection::ResetStatementStatistics()
+{
+    Mutex::ScopedLock lock(&g_statisticsMutex);
+    g_statementStatistics.clear();
+}
+
+void SqlConnection::SetSlowQueryThreshold(uint64_t threshold)
+{
+    Mutex::ScopedLock lock(&g_statisticsMutex);
+    g_slowQueryThreshold = threshold;
 }
 
 } // namespace DB
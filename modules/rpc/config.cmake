@@ -26,6 +26,7 @@ SET(DPL_RPC_SOURCES
     ${PROJECT_SOURCE_DIR}/modules/rpc/src/generic_socket_rpc_client.cpp
     ${PROJECT_SOURCE_DIR}/modules/rpc/src/generic_socket_rpc_connection.cpp
     ${PROJECT_SOURCE_DIR}/modules/rpc/src/generic_socket_rpc_server.cpp
+    ${PROJECT_SOURCE_DIR}/modules/rpc/src/rpc_reply_future.cpp
     ${PROJECT_SOURCE_DIR}/modules/rpc/src/unix_socket_rpc_client.cpp
     ${PROJECT_SOURCE_DIR}/modules/rpc/src/unix_socket_rpc_connection.cpp
     ${PROJECT_SOURCE_DIR}/modules/rpc/src/unix_socket_rpc_server.cpp
@@ -40,6 +41,7 @@ SET(DPL_RPC_HEADERS
     ${PROJECT_SOURCE_DIR}/modules/rpc/include/dpl/rpc/generic_socket_rpc_connection.h
     ${PROJECT_SOURCE_DIR}/modules/rpc/include/dpl/rpc/generic_socket_rpc_server.h
     ${PROJECT_SOURCE_DIR}/modules/rpc/include/dpl/rpc/rpc_function.h
+    ${PROJECT_SOURCE_DIR}/modules/rpc/include/dpl/rpc/rpc_reply_future.h
     ${PROJECT_SOURCE_DIR}/modules/rpc/include/dpl/rpc/unix_socket_rpc_client.h
     ${PROJECT_SOURCE_DIR}/modules/rpc/include/dpl/rpc/unix_socket_rpc_connection.h
     ${PROJECT_SOURCE_DIR}/modules/rpc/include/dpl/rpc/unix_socket_rpc_server.h
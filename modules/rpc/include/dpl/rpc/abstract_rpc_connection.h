@@ -23,6 +23,8 @@
 #define DPL_ABSTRACT_RPC_CONNECTION_H
 
 #include <dpl/rpc/rpc_function.h>
+#include <dpl/rpc/rpc_reply_future.h>
+#include <dpl/fast_delegate.h>
 #include <dpl/exception.h>
 #include <dpl/generic_event.h>
 #include <dpl/event/event_support.h>
@@ -33,6 +35,25 @@ namespace DPL
 {
 namespace RPC
 {
+/**
+ * Identifier of data stream, unique among streams opened
+ * by one side of connection
+ */
+typedef unsigned RPCStreamId;
+
+/**
+ * Identifier of call expecting reply, unique among calls pending
+ * on one side of connection
+ */
+typedef unsigned RPCCallId;
+
+/**
+ * Reply delegate, called in context of connection with call identifier,
+ * final call status and reply function (empty unless call is replied)
+ */
+typedef FastDelegate3<RPCCallId, RPCCallStatus::Type, const RPCFunction &>
+    RPCReplyDelegate;
+
 namespace AbstractRPCConnectionEvents
 {
 /**
@@ -40,6 +61,21 @@ namespace AbstractRPCConnectionEvents
  */
 DECLARE_GENERIC_EVENT_1(AsyncCallEvent, RPCFunction)
 
+/**
+ * Call event, receiver answers it with AbstractRPCConnection::Reply
+ */
+DECLARE_GENERIC_EVENT_2(CallEvent, RPCCallId, RPCFunction)
+
+/**
+ * Stream data event, emitted for every received chunk of stream
+ */
+DECLARE_GENERIC_EVENT_2(StreamDataEvent, RPCStreamId, BinaryQueue)
+
+/**
+ * Stream end event, emitted after last chunk of stream
+ */
+DECLARE_GENERIC_EVENT_1(StreamEndEvent, RPCStreamId)
+
 /**
  * Connection closed event
  */
@@ -53,6 +89,9 @@ DECLARE_GENERIC_EVENT_0(ConnectionBrokenEvent)
 
 class AbstractRPCConnection
     : public DPL::Event::EventSupport<AbstractRPCConnectionEvents::AsyncCallEvent>,
+      public DPL::Event::EventSupport<AbstractRPCConnectionEvents::CallEvent>,
+      public DPL::Event::EventSupport<AbstractRPCConnectionEvents::StreamDataEvent>,
+      public DPL::Event::EventSupport<AbstractRPCConnectionEvents::StreamEndEvent>,
       public DPL::Event::EventSupport<AbstractRPCConnectionEvents::ConnectionClosedEvent>,
       public DPL::Event::EventSupport<AbstractRPCConnectionEvents::ConnectionBrokenEvent>
 {
@@ -62,7 +101,9 @@ public:
     public:
         DECLARE_EXCEPTION_TYPE(DPL::Exception, Base)
         DECLARE_EXCEPTION_TYPE(Base, AsyncCallFailed)
+        DECLARE_EXCEPTION_TYPE(Base, CallFailed)
         DECLARE_EXCEPTION_TYPE(Base, PingFailed)
+        DECLARE_EXCEPTION_TYPE(Base, StreamFailed)
     };
 
 public:
@@ -76,6 +117,46 @@ public:
      */
     virtual void AsyncCall(const RPCFunction &function) = 0;
 
+    /**
+     * Call RPC function and expect reply
+     * Many calls may be pending at once, replies may come in any order.
+     * Delegate is called exactly once, unless connection is destroyed before.
+     * It is called from event loop of connection context, never from within
+     * connection methods. Connection must not be destroyed from within
+     * delegate. Default implementation throws Exception::CallFailed.
+     *
+     * @param function Constant reference to RPC function to call
+     * @param delegate Delegate called when call is completed
+     * @param timeout Time in seconds to wait for reply, zero to wait forever
+     * @return Identifier of call
+     */
+    virtual RPCCallId Call(const RPCFunction &function,
+                           RPCReplyDelegate delegate,
+                           double timeout);
+
+    /**
+     * Call RPC function and expect reply
+     * Returned future is completed with cancelled status when connection
+     * is destroyed before reply.
+     * Default implementation throws Exception::CallFailed.
+     *
+     * @param function Constant reference to RPC function to call
+     * @param timeout Time in seconds to wait for reply, zero to wait forever
+     * @return Future completed when call is completed
+     */
+    virtual RPCReplyFuturePtr Call(const RPCFunction &function,
+                                   double timeout);
+
+    /**
+     * Reply to call received with call event
+     * Default implementation throws Exception::CallFailed.
+     *
+     * @param callId Identifier of call from call event
+     * @param reply Constant reference to reply function
+     * @return none
+     */
+    virtual void Reply(RPCCallId callId, const RPCFunction &reply);
+
     /**
      * Ping RPC connection
      * This will send a ping/pong packet over connection to ensure it is alive
@@ -84,6 +165,33 @@ public:
      * @return none
      */
     virtual void Ping() = 0;
+
+    /**
+     * Open outgoing data stream
+     * Data written to stream is sent in chunks, so neither side has to hold
+     * whole data. Peer receives stream data and stream end events.
+     * Default implementation throws Exception::StreamFailed.
+     *
+     * @return Identifier of opened stream
+     */
+    virtual RPCStreamId OpenStream();
+
+    /**
+     * Send data over stream opened with OpenStream
+     *
+     * @param streamId Identifier of stream
+     * @param data Constant reference to data to send
+     * @return none
+     */
+    virtual void WriteStream(RPCStreamId streamId, const BinaryQueue &data);
+
+    /**
+     * Close stream opened with OpenStream
+     *
+     * @param streamId Identifier of stream
+     * @return none
+     */
+    virtual void CloseStream(RPCStreamId streamId);
 };
 
 /**
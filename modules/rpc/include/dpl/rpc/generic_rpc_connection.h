@@ -25,16 +25,40 @@
 #include <dpl/rpc/abstract_rpc_connection.h>
 #include <dpl/abstract_waitable_input_output.h>
 #include <dpl/socket/waitable_input_output_execution_context_support.h>
+#include <dpl/event/controller.h>
+#include <dpl/generic_event.h>
+#include <dpl/type_list.h>
 #include <dpl/scoped_ptr.h>
+#include <set>
+#include <map>
 
 namespace DPL
 {
 namespace RPC
 {
+namespace GenericRPCConnectionEvents
+{
+/**
+ * Internal timed event, emitted when call timeout elapses
+ */
+DECLARE_GENERIC_EVENT_1(CallTimeoutEvent, RPCCallId)
+
+/**
+ * Internal event, emitted when call is replied or cancelled, so that
+ * reply delegates never run inside connection methods
+ */
+DECLARE_GENERIC_EVENT_3(CallCompletedEvent,
+                        RPCCallId,
+                        RPCCallStatus::Type,
+                        RPCFunction)
+} // namespace GenericRPCConnectionEvents
 
 class GenericRPCConnection
     : public AbstractRPCConnection,
-      private DPL::Socket::WaitableInputOutputExecutionContextSupport
+      private DPL::Socket::WaitableInputOutputExecutionContextSupport,
+      private DPL::Event::Controller<DPL::TypeListDecl<
+          GenericRPCConnectionEvents::CallTimeoutEvent,
+          GenericRPCConnectionEvents::CallCompletedEvent>::Type>
 {
 private:
     // WaitableInputOutputExecutionContextSupport
@@ -42,8 +66,46 @@ private:
     virtual void OnInputStreamClosed();
     virtual void OnInputStreamBroken();
 
+    // Controller
+    virtual void OnEventReceived(
+        const GenericRPCConnectionEvents::CallTimeoutEvent &event);
+    virtual void OnEventReceived(
+        const GenericRPCConnectionEvents::CallCompletedEvent &event);
+
     ScopedPtr<AbstractWaitableInputOutput> m_inputOutput;
 
+    RPCStreamId m_nextStreamId;
+    std::set<RPCStreamId> m_openStreams;
+
+    struct PendingCall
+    {
+        RPCReplyDelegate delegate;
+        RPCReplyFuturePtr future;
+    };
+
+    typedef std::map<RPCCallId, PendingCall> PendingCallMap;
+
+    RPCCallId m_nextCallId;
+    PendingCallMap m_pendingCalls;
+
+    // Set after malformed packet, rest of input is ignored
+    bool m_protocolError;
+
+    void SendPacket(unsigned char type, BinaryQueue &payload);
+    bool ParsePacket();
+    void OnProtocolError();
+
+    RPCCallId SendCall(const RPCFunction &function,
+                       const PendingCall &pendingCall,
+                       double timeout);
+    void PostCallCompleted(RPCCallId callId,
+                           RPCCallStatus::Type status,
+                           const RPCFunction &reply);
+    void CompleteCall(RPCCallId callId,
+                      RPCCallStatus::Type status,
+                      const RPCFunction &reply);
+    void CancelPendingCalls();
+
 public:
     /**
      * Costructor
@@ -54,7 +116,25 @@ public:
     virtual ~GenericRPCConnection();
 
     virtual void AsyncCall(const RPCFunction &function);
+    virtual RPCCallId Call(const RPCFunction &function,
+                           RPCReplyDelegate delegate,
+                           double timeout);
+    virtual RPCReplyFuturePtr Call(const RPCFunction &function,
+                                   double timeout);
+    virtual void Reply(RPCCallId callId, const RPCFunction &reply);
     virtual void Ping();
+
+    virtual RPCStreamId OpenStream();
+    virtual void WriteStream(RPCStreamId streamId, const BinaryQueue &data);
+    virtual void CloseStream(RPCStreamId streamId);
+
+    // Output corking, see WaitableInputOutputExecutionContextSupport
+    typedef WaitableInputOutputExecutionContextSupport::OutputCorkingStats
+        OutputCorkingStats;
+
+    using WaitableInputOutputExecutionContextSupport::SetOutputCorking;
+    using WaitableInputOutputExecutionContextSupport::GetOutputCorkingStats;
+    using WaitableInputOutputExecutionContextSupport::FlushOutput;
 };
 
 }
@@ -27,18 +27,25 @@
 #include <dpl/scoped_array.h>
 #include <dpl/string.h>
 #include <dpl/serialization.h>
+#include <dpl/noncopyable.h>
 #include <string>
+#include <cstring>
+#include <cstdlib>
+#include <new>
 
 namespace DPL
 {
 namespace RPC
 {
+class RPCFunctionBuilder;
 
 class RPCFunction : public IStream
 {
 protected:
     BinaryQueue m_buffer; ///< Serialized RPC function call as a binary queue
 
+    friend class RPCFunctionBuilder;
+
 public:
     class Exception
     {
@@ -151,9 +158,16 @@ public:
         {
             std::string::size_type size;
             m_buffer.FlattenConsume(&size, sizeof(size));
-            ScopedArray<char> str(new char[size]);
-            m_buffer.FlattenConsume(str.Get(), size);
-            arg = std::string(str.Get(), str.Get() + size);
+
+            // Do not allocate for broken size
+            if (size > m_buffer.Size())
+                ThrowMsg(Exception::ParseFailed, "Unexpected end of stream");
+
+            // Read in place, without intermediate buffer
+            arg.resize(size);
+
+            if (size > 0)
+                m_buffer.FlattenConsume(&arg[0], size);
         }
         Catch (BinaryQueue::Exception::OutOfData)
         {
@@ -207,6 +221,170 @@ public:
     }
 };
 
+
+/**
+ * Builder of RPC function arguments in one contiguous buffer
+ *
+ * RPCFunction::AppendArg copies length and value of each argument
+ * separately. Builder writes them to single buffer, sized up front
+ * when size hint is given, and hands the buffer to function as one
+ * bucket. Encoding is the same, so arguments are consumed with
+ * RPCFunction::ConsumeArg.
+ */
+class RPCFunctionBuilder
+    : private Noncopyable
+{
+private:
+    unsigned char *m_data;
+    size_t m_size;
+    size_t m_capacity;
+
+    void Reserve(size_t size)
+    {
+        if (m_size + size <= m_capacity)
+            return;
+
+        size_t capacity = m_capacity * 2;
+
+        if (capacity < m_size + size)
+            capacity = m_size + size;
+
+        void *data = realloc(m_data, capacity);
+
+        if (data == NULL)
+            throw std::bad_alloc();
+
+        m_data = static_cast<unsigned char *>(data);
+        m_capacity = capacity;
+    }
+
+    void AppendRaw(const void *buffer, size_t bufferSize)
+    {
+        Reserve(bufferSize);
+        memcpy(m_data + m_size, buffer, bufferSize);
+        m_size += bufferSize;
+    }
+
+    void AppendSized(const void *buffer, size_t bufferSize)
+    {
+        Reserve(sizeof(bufferSize) + bufferSize);
+        AppendRaw(&bufferSize, sizeof(bufferSize));
+        AppendRaw(buffer, bufferSize);
+    }
+
+public:
+    /**
+     * Constructor
+     *
+     * @param sizeHint Expected size of all arguments, see EstimateArgSize
+     */
+    explicit RPCFunctionBuilder(size_t sizeHint = 0)
+        : m_data(NULL),
+          m_size(0),
+          m_capacity(0)
+    {
+        Reserve(sizeHint);
+    }
+
+    ~RPCFunctionBuilder()
+    {
+        free(m_data);
+    }
+
+    /**
+     * @return Encoded size of argument
+     */
+    template<typename Type>
+    static size_t EstimateArgSize(const Type &arg)
+    {
+        return sizeof(size_t) + sizeof(arg);
+    }
+
+    /**
+     * @return Encoded size of @a std::string argument
+     */
+    static size_t EstimateArgSize(const std::string &arg)
+    {
+        return sizeof(size_t) + arg.size();
+    }
+
+    /**
+     * @return Encoded size of @a DPL::String argument, exact for ASCII only
+     */
+    static size_t EstimateArgSize(const String &arg)
+    {
+        return sizeof(size_t) + arg.size();
+    }
+
+    /**
+     * Append argument, encoded as by RPCFunction::AppendArg
+     *
+     * @param[in] arg Template based argument to append
+     * @return Reference to this builder
+     * @warning Carefully add any pointers to buffer because of template nature of this method
+     */
+    template<typename Type>
+    RPCFunctionBuilder &AppendArg(const Type &arg)
+    {
+        AppendSized(&arg, sizeof(arg));
+        return *this;
+    }
+
+    /**
+     * Append @a std::string argument
+     *
+     * @param[in] arg String to append
+     * @return Reference to this builder
+     */
+    RPCFunctionBuilder &AppendArg(const std::string &arg)
+    {
+        AppendSized(arg.data(), arg.size());
+        return *this;
+    }
+
+    /**
+     * Append @a DPL::String argument, converted to UTF-8
+     *
+     * @param[in] arg String to append
+     * @return Reference to this builder
+     */
+    RPCFunctionBuilder &AppendArg(const String &arg)
+    {
+        std::string localStdString = ToUTF8String(arg);
+        return AppendArg(localStdString);
+    }
+
+    /**
+     * @return Size of arguments appended so far
+     */
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Move appended arguments to the end of function as one bucket.
+     * Builder is empty afterwards and may be reused.
+     *
+     * @param[out] function Function to append arguments to
+     * @return none
+     */
+    void MoveTo(RPCFunction &function)
+    {
+        unsigned char *data = m_data;
+        size_t size = m_size;
+
+        m_data = NULL;
+        m_size = 0;
+        m_capacity = 0;
+
+        // Frees buffer if empty
+        function.m_buffer.AppendUnmanaged(data, size,
+                                          &BinaryQueue::BufferDeleterFree,
+                                          NULL);
+    }
+};
+
 }
 } // namespace DPL
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        rpc_reply_future.h
+ * @version     1.0
+ * @brief       This file is the header file for RPC reply future
+ */
+#ifndef DPL_RPC_REPLY_FUTURE_H
+#define DPL_RPC_REPLY_FUTURE_H
+
+#include <dpl/rpc/rpc_function.h>
+#include <dpl/waitable_event.h>
+#include <dpl/waitable_handle.h>
+#include <dpl/noncopyable.h>
+#include <dpl/shared_ptr.h>
+#include <dpl/mutex.h>
+
+namespace DPL
+{
+namespace RPC
+{
+namespace RPCCallStatus
+{
+enum Type
+{
+    Pending,    ///< No reply yet
+    Replied,    ///< Peer replied, reply function is valid
+    TimedOut,   ///< No reply within call timeout
+    Cancelled   ///< Connection was closed, broken or destroyed
+};
+} // namespace RPCCallStatus
+
+/**
+ * Result of call made with AbstractRPCConnection::Call
+ *
+ * Future is completed in context of connection. Other threads may wait
+ * for its waitable handle. Connection context must not wait for it,
+ * because reply is read by the same context.
+ */
+class RPCReplyFuture
+    : private Noncopyable
+{
+private:
+    mutable Mutex m_mutex;
+    WaitableEvent m_readyEvent;
+    RPCCallStatus::Type m_status;
+    RPCFunction m_reply;
+
+public:
+    RPCReplyFuture();
+    virtual ~RPCReplyFuture();
+
+    /**
+     * Complete future, called by connection
+     *
+     * @param status Final status of call
+     * @param reply Reply function, meaningful for replied calls only
+     * @return none
+     */
+    void Complete(RPCCallStatus::Type status, const RPCFunction &reply);
+
+    /**
+     * @return true if call is completed with any status
+     */
+    bool IsReady() const;
+
+    /**
+     * @return Current status of call
+     */
+    RPCCallStatus::Type GetStatus() const;
+
+    /**
+     * @return Copy of reply function, empty unless call is replied
+     */
+    RPCFunction GetReply() const;
+
+    /**
+     * @return Handle signaled when call is completed
+     */
+    WaitableHandle GetWaitableHandle() const;
+};
+
+typedef SharedPtr<RPCReplyFuture> RPCReplyFuturePtr;
+
+}
+} // namespace DPL
+
+#endif // DPL_RPC_REPLY_FUTURE_H
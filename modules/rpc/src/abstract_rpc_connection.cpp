@@ -21,10 +21,59 @@
  */
 #include <dpl/rpc/abstract_rpc_connection.h>
 
-//
-// Note:
-//
-// The file here is left blank to enable precompilation
-// of templates in corresponding header file.
-// Do not remove this file.
-//
+namespace DPL
+{
+namespace RPC
+{
+// Calls and streams are not supported unless connection implements them
+
+RPCCallId AbstractRPCConnection::Call(const RPCFunction &function,
+                                      RPCReplyDelegate delegate,
+                                      double timeout)
+{
+    (void)function;
+    (void)delegate;
+    (void)timeout;
+
+    ThrowMsg(Exception::CallFailed, "Calls with reply are not supported");
+}
+
+RPCReplyFuturePtr AbstractRPCConnection::Call(const RPCFunction &function,
+                                              double timeout)
+{
+    (void)function;
+    (void)timeout;
+
+    ThrowMsg(Exception::CallFailed, "Calls with reply are not supported");
+}
+
+void AbstractRPCConnection::Reply(RPCCallId callId, const RPCFunction &reply)
+{
+    (void)callId;
+    (void)reply;
+
+    ThrowMsg(Exception::CallFailed, "Calls with reply are not supported");
+}
+
+RPCStreamId AbstractRPCConnection::OpenStream()
+{
+    ThrowMsg(Exception::StreamFailed, "Streams are not supported");
+}
+
+void AbstractRPCConnection::WriteStream(RPCStreamId streamId,
+                                        const BinaryQueue &data)
+{
+    (void)streamId;
+    (void)data;
+
+    ThrowMsg(Exception::StreamFailed, "Streams are not supported");
+}
+
+void AbstractRPCConnection::CloseStream(RPCStreamId streamId)
+{
+    (void)streamId;
+
+    ThrowMsg(Exception::StreamFailed, "Streams are not supported");
+}
+}
+} // namespace DPL
@@ -23,7 +23,10 @@
 #include <dpl/scoped_array.h>
 #include <dpl/log/log.h>
 #include <dpl/aligned.h>
+#include <dpl/foreach.h>
 #include <stdexcept>
+#include <stdint.h>
+#include <algorithm>
 
 namespace DPL
 {
@@ -33,31 +36,61 @@ namespace // anonymous
 {
 namespace Protocol
 {
+// Version 2 has 32-bit packet size, streams and calls with reply
+const unsigned char VERSION = 2;
+
+// Larger packets are treated as broken stream
+const uint32_t MAX_PACKET_SIZE = 64 * 1024 * 1024;
+
+// Stream data is sent in packets of at most this size
+const size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
 // Packet definitions
 enum PacketType
 {
     PacketType_AsyncCall,
-    PacketType_PingPong
+    PacketType_PingPong,
+    PacketType_StreamData, ///< Stream id followed by chunk of data
+    PacketType_StreamEnd,  ///< Stream id
+    PacketType_Call,       ///< Call id followed by serialized call
+    PacketType_Reply       ///< Call id followed by serialized reply
 };
 
 struct Header
 {
-    unsigned short size;
-    unsigned short type;
+    unsigned char version;
+    unsigned char type;
+    unsigned short reserved;
+    uint32_t size;
 } DPL_ALIGNED(1);
 
-struct AsyncCall
-    : public Header
+} // namespace Protocol
+
+// Move bytes from the front of input queue to output queue with one copy
+void ConsumeTo(BinaryQueue &input, size_t size, BinaryQueue &output)
 {
-    unsigned char data[1];
-} DPL_ALIGNED(1);
+    if (size == 0)
+        return;
 
-} // namespace Protocol
+    void *buffer = malloc(size);
+
+    if (buffer == NULL)
+        throw std::bad_alloc();
+
+    input.FlattenConsume(buffer, size);
+    output.AppendUnmanaged(buffer, size, &BinaryQueue::BufferDeleterFree, NULL);
+}
 } // namespace anonymous
 
 GenericRPCConnection::GenericRPCConnection(AbstractWaitableInputOutput *inputOutput)
-    : m_inputOutput(inputOutput)
+    : m_inputOutput(inputOutput),
+      m_nextStreamId(0),
+      m_nextCallId(0),
+      m_protocolError(false)
 {
+    // Call timeouts are delivered to current context
+    Touch();
+
     LogPedantic("Opening generic RPC...");
     WaitableInputOutputExecutionContextSupport::Open(inputOutput);
     LogPedantic("Generic RPC opened");
@@ -69,6 +102,29 @@ GenericRPCConnection::~GenericRPCConnection()
     LogPedantic("Closing generic RPC...");
     WaitableInputOutputExecutionContextSupport::Close();
     LogPedantic("Generic RPC closed");
+
+    // Release waiters of pending calls, delegates are not called anymore
+    FOREACH(iterator, m_pendingCalls)
+    {
+        if (iterator->second.future)
+            iterator->second.future->Complete(RPCCallStatus::Cancelled,
+                                              RPCFunction());
+    }
+}
+
+void GenericRPCConnection::SendPacket(unsigned char type, BinaryQueue &payload)
+{
+    Protocol::Header header;
+    header.version = Protocol::VERSION;
+    header.type = type;
+    header.reserved = 0;
+    header.size = static_cast<uint32_t>(payload.Size());
+
+    m_outputStream.AppendCopy(&header, sizeof(header));
+    m_outputStream.AppendMoveFrom(payload);
+
+    // Try to feed output with data
+    FeedOutput();
 }
 
 void GenericRPCConnection::AsyncCall(const RPCFunction &function)
@@ -78,18 +134,13 @@ void GenericRPCConnection::AsyncCall(const RPCFunction &function)
     // Create binary call
     BinaryQueue serializedCall = function.Serialize();
 
-    // Append buffers
-    Protocol::AsyncCall call;
-    call.size = static_cast<unsigned short>(serializedCall.Size());
-    call.type = Protocol::PacketType_AsyncCall;
-
-    m_outputStream.AppendCopy(&call, sizeof(Protocol::Header));
-    m_outputStream.AppendMoveFrom(serializedCall);
+    if (serializedCall.Size() > Protocol::MAX_PACKET_SIZE)
+        ThrowMsg(AbstractRPCConnection::Exception::AsyncCallFailed,
+                 "Call of size " << serializedCall.Size() << " is too large");
 
-    // Try to feed output with data
     Try
     {
-        FeedOutput();
+        SendPacket(Protocol::PacketType_AsyncCall, serializedCall);
     }
     Catch (WaitableInputOutputExecutionContextSupport::Exception::NotOpened)
     {
@@ -98,21 +149,165 @@ void GenericRPCConnection::AsyncCall(const RPCFunction &function)
     }
 }
 
+RPCCallId GenericRPCConnection::SendCall(const RPCFunction &function,
+                                         const PendingCall &pendingCall,
+                                         double timeout)
+{
+    BinaryQueue serializedCall = function.Serialize();
+
+    if (serializedCall.Size() + sizeof(uint32_t) > Protocol::MAX_PACKET_SIZE)
+        ThrowMsg(AbstractRPCConnection::Exception::CallFailed,
+                 "Call of size " << serializedCall.Size() << " is too large");
+
+    // Skip identifiers of calls still pending after wrap around
+    while (m_pendingCalls.find(m_nextCallId) != m_pendingCalls.end())
+        ++m_nextCallId;
+
+    RPCCallId callId = m_nextCallId++;
+
+    uint32_t id = callId;
+    BinaryQueue packet;
+    packet.AppendCopy(&id, sizeof(id));
+    packet.AppendMoveFrom(serializedCall);
+
+    Try
+    {
+        SendPacket(Protocol::PacketType_Call, packet);
+    }
+    Catch (WaitableInputOutputExecutionContextSupport::Exception::NotOpened)
+    {
+        ReThrow(AbstractRPCConnection::Exception::CallFailed);
+    }
+
+    m_pendingCalls.insert(std::make_pair(callId, pendingCall));
+
+    if (timeout > 0.0)
+        DPL::Event::ControllerEventHandler<
+            GenericRPCConnectionEvents::CallTimeoutEvent>::PostTimedEvent(
+                GenericRPCConnectionEvents::CallTimeoutEvent(callId), timeout);
+
+    LogPedantic("Call " << callId << " sent, " << m_pendingCalls.size() <<
+                " calls pending");
+
+    return callId;
+}
+
+RPCCallId GenericRPCConnection::Call(const RPCFunction &function,
+                                     RPCReplyDelegate delegate,
+                                     double timeout)
+{
+    LogPedantic("Executing call with reply delegate");
+
+    PendingCall pendingCall;
+    pendingCall.delegate = delegate;
+
+    return SendCall(function, pendingCall, timeout);
+}
+
+RPCReplyFuturePtr GenericRPCConnection::Call(const RPCFunction &function,
+                                             double timeout)
+{
+    LogPedantic("Executing call with reply future");
+
+    PendingCall pendingCall;
+    pendingCall.future = RPCReplyFuturePtr(new RPCReplyFuture());
+
+    SendCall(function, pendingCall, timeout);
+    return pendingCall.future;
+}
+
+void GenericRPCConnection::Reply(RPCCallId callId, const RPCFunction &reply)
+{
+    LogPedantic("Replying to call " << callId);
+
+    BinaryQueue serializedReply = reply.Serialize();
+
+    if (serializedReply.Size() + sizeof(uint32_t) > Protocol::MAX_PACKET_SIZE)
+        ThrowMsg(AbstractRPCConnection::Exception::CallFailed,
+                 "Reply of size " << serializedReply.Size() << " is too large");
+
+    uint32_t id = callId;
+    BinaryQueue packet;
+    packet.AppendCopy(&id, sizeof(id));
+    packet.AppendMoveFrom(serializedReply);
+
+    Try
+    {
+        SendPacket(Protocol::PacketType_Reply, packet);
+    }
+    Catch (WaitableInputOutputExecutionContextSupport::Exception::NotOpened)
+    {
+        ReThrow(AbstractRPCConnection::Exception::CallFailed);
+    }
+}
+
+void GenericRPCConnection::CompleteCall(RPCCallId callId,
+                                        RPCCallStatus::Type status,
+                                        const RPCFunction &reply)
+{
+    PendingCallMap::iterator iterator = m_pendingCalls.find(callId);
+
+    if (iterator == m_pendingCalls.end())
+    {
+        // Already timed out or cancelled
+        LogPedantic("Call " << callId << " is not pending");
+        return;
+    }
+
+    // Delegate may make new calls
+    PendingCall pendingCall = iterator->second;
+    m_pendingCalls.erase(iterator);
+
+    LogPedantic("Call " << callId << " completed with status: " <<
+                static_cast<int>(status));
+
+    if (!pendingCall.delegate.empty())
+        pendingCall.delegate(callId, status, reply);
+
+    if (pendingCall.future)
+        pendingCall.future->Complete(status, reply);
+}
+
+void GenericRPCConnection::PostCallCompleted(RPCCallId callId,
+                                             RPCCallStatus::Type status,
+                                             const RPCFunction &reply)
+{
+    // Delegates run from event loop, not from input handler which may
+    // still use connection after delegate returns or destroys it
+    DPL::Event::ControllerEventHandler<
+        GenericRPCConnectionEvents::CallCompletedEvent>::PostEvent(
+            GenericRPCConnectionEvents::CallCompletedEvent(
+                callId, status, reply));
+}
+
+void GenericRPCConnection::CancelPendingCalls()
+{
+    FOREACH(iterator, m_pendingCalls)
+        PostCallCompleted(iterator->first, RPCCallStatus::Cancelled,
+                          RPCFunction());
+}
+
+void GenericRPCConnection::OnEventReceived(
+    const GenericRPCConnectionEvents::CallTimeoutEvent &event)
+{
+    CompleteCall(event.GetArg0(), RPCCallStatus::TimedOut, RPCFunction());
+}
+
+void GenericRPCConnection::OnEventReceived(
+    const GenericRPCConnectionEvents::CallCompletedEvent &event)
+{
+    CompleteCall(event.GetArg0(), event.GetArg1(), event.GetArg2());
+}
+
 void GenericRPCConnection::Ping()
 {
     LogPedantic("Executing ping call");
 
-    // Append buffers
-    Protocol::AsyncCall call;
-    call.size = 0;
-    call.type = Protocol::PacketType_PingPong;
-
-    m_outputStream.AppendCopy(&call, sizeof(Protocol::Header));
+    BinaryQueue empty;
 
-    // Try to feed output with data
     Try
     {
-        FeedOutput();
+        SendPacket(Protocol::PacketType_PingPong, empty);
     }
     Catch (WaitableInputOutputExecutionContextSupport::Exception::NotOpened)
     {
@@ -121,87 +316,252 @@ void GenericRPCConnection::Ping()
     }
 }
 
-void GenericRPCConnection::OnInputStreamRead()
+RPCStreamId GenericRPCConnection::OpenStream()
 {
-    LogPedantic("Interpreting " << m_inputStream.Size() << " bytes buffer");
+    // Stream is announced by its first packet
+    RPCStreamId streamId = m_nextStreamId++;
+    m_openStreams.insert(streamId);
 
-    // Enough bytes to read at least one header ?
-    if (m_inputStream.Size() >= sizeof(Protocol::Header))
+    LogPedantic("Opened stream: " << streamId);
+    return streamId;
+}
+
+void GenericRPCConnection::WriteStream(RPCStreamId streamId,
+                                       const BinaryQueue &data)
+{
+    if (m_openStreams.find(streamId) == m_openStreams.end())
+        ThrowMsg(AbstractRPCConnection::Exception::StreamFailed,
+                 "Stream " << streamId << " is not opened");
+
+    LogPedantic("Writing " << data.Size() << " bytes to stream: " << streamId);
+
+    BinaryQueue left(data);
+
+    Try
     {
-        // Begin consuming as much packets as it is possible
-        while (m_inputStream.Size() >= sizeof(Protocol::Header))
+        while (!left.Empty())
         {
-            Protocol::Header header;
-            m_inputStream.Flatten(&header, sizeof(header));
+            uint32_t id = streamId;
+            BinaryQueue packet;
+            packet.AppendCopy(&id, sizeof(id));
+            ConsumeTo(left, std::min(left.Size(), Protocol::STREAM_CHUNK_SIZE), packet);
+
+            SendPacket(Protocol::PacketType_StreamData, packet);
+        }
+    }
+    Catch (WaitableInputOutputExecutionContextSupport::Exception::NotOpened)
+    {
+        ReThrow(AbstractRPCConnection::Exception::StreamFailed);
+    }
+}
+
+void GenericRPCConnection::CloseStream(RPCStreamId streamId)
+{
+    if (m_openStreams.erase(streamId) == 0)
+        ThrowMsg(AbstractRPCConnection::Exception::StreamFailed,
+                 "Stream " << streamId << " is not opened");
+
+    LogPedantic("Closing stream: " << streamId);
+
+    uint32_t id = streamId;
+    BinaryQueue packet;
+    packet.AppendCopy(&id, sizeof(id));
+
+    Try
+    {
+        SendPacket(Protocol::PacketType_StreamEnd, packet);
+    }
+    Catch (WaitableInputOutputExecutionContextSupport::Exception::NotOpened)
+    {
+        ReThrow(AbstractRPCConnection::Exception::StreamFailed);
+    }
+}
+
+void GenericRPCConnection::OnProtocolError()
+{
+    m_protocolError = true;
+    m_inputStream.Clear();
+
+    CancelPendingCalls();
+
+    DPL::Event::EventSupport<AbstractRPCConnectionEvents::ConnectionBrokenEvent>::
+        EmitEvent(AbstractRPCConnectionEvents::ConnectionBrokenEvent(
+            EventSender(this)), DPL::Event::EmitMode::Queued);
+}
+
+bool GenericRPCConnection::ParsePacket()
+{
+    // Enough bytes to read at least one header ?
+    if (m_inputStream.Size() < sizeof(Protocol::Header))
+    {
+        LogPedantic("Too few bytes to read header");
+        return false;
+    }
+
+    Protocol::Header header;
+    m_inputStream.Flatten(&header, sizeof(header));
+
+    if (header.version != Protocol::VERSION)
+    {
+        LogError("Unsupported RPC protocol version: " <<
+                 static_cast<int>(header.version));
+        OnProtocolError();
+        return false;
+    }
+
+    if (header.size > Protocol::MAX_PACKET_SIZE)
+    {
+        LogError("RPC packet of size " << header.size << " is too large");
+        OnProtocolError();
+        return false;
+    }
 
-            if (m_inputStream.Size() >= sizeof(Protocol::Header) + header.size)
+    if (m_inputStream.Size() < sizeof(Protocol::Header) + header.size)
+    {
+        LogPedantic("Too few bytes to read packet");
+        return false;
+    }
+
+    LogPedantic("Will parse packet of type: " << static_cast<int>(header.type));
+
+    m_inputStream.Consume(sizeof(Protocol::Header));
+
+    // Parse specific packet
+    switch (header.type)
+    {
+        case Protocol::PacketType_AsyncCall:
             {
-                LogPedantic("Will parse packet of type: " << header.type);
+                BinaryQueue call;
+                ConsumeTo(m_inputStream, header.size, call);
 
-                // Allocate new packet (header + real packet data)
-                void *binaryPacket = malloc(sizeof(Protocol::Header) + header.size);
+                LogPedantic("Async call of size: " << header.size << " parsed");
 
-                if (binaryPacket == NULL)
-                    throw std::bad_alloc();
+                // Call async call event listeners
+                DPL::Event::EventSupport<AbstractRPCConnectionEvents::AsyncCallEvent>::
+                    EmitEvent(AbstractRPCConnectionEvents::AsyncCallEvent(
+                        RPCFunction(call), EventSender(this)), DPL::Event::EmitMode::Queued);
+            }
+            break;
 
-                // Get it from stream
-                m_inputStream.FlattenConsume(binaryPacket, sizeof(Protocol::Header) + header.size);
+        case Protocol::PacketType_PingPong:
+            {
+                m_inputStream.Consume(header.size);
 
-                // Parse specific packet
-                switch (header.type)
-                {
-                    case Protocol::PacketType_AsyncCall:
-                        {
-                            BinaryQueue call;
+                // Reply with ping/pong
+                Ping();
 
-                            // No need to delete packet data, we can use it
-                            call.AppendUnmanaged(binaryPacket, sizeof(Protocol::Header) + header.size, &BinaryQueue::BufferDeleterFree, NULL);
+                LogPedantic("Ping pong replied");
+            }
+            break;
 
-                            // ...but just remove protocol header
-                            call.Consume(sizeof(Protocol::Header));
+        case Protocol::PacketType_StreamData:
+        case Protocol::PacketType_StreamEnd:
+            {
+                uint32_t streamId;
 
-                            LogPedantic("Async call of size: " << header.size << " parsed");
+                if (header.size < sizeof(streamId))
+                {
+                    LogError("Stream packet without stream id");
+                    OnProtocolError();
+                    return false;
+                }
+
+                m_inputStream.FlattenConsume(&streamId, sizeof(streamId));
 
-                            // Call async call event listeners
-                            DPL::Event::EventSupport<AbstractRPCConnectionEvents::AsyncCallEvent>::
-                                EmitEvent(AbstractRPCConnectionEvents::AsyncCallEvent(
-                                    RPCFunction(call), EventSender(this)), DPL::Event::EmitMode::Queued);
-                        }
-                        break;
+                if (header.type == Protocol::PacketType_StreamData)
+                {
+                    BinaryQueue chunk;
+                    ConsumeTo(m_inputStream, header.size - sizeof(streamId), chunk);
 
-                    case Protocol::PacketType_PingPong:
-                        {
-                            // Reply with ping/pong
-                            Ping();
+                    LogPedantic("Stream " << streamId << " chunk of size: " <<
+                                chunk.Size() << " parsed");
 
-                            // Do not need packet data
-                            free(binaryPacket);
+                    DPL::Event::EventSupport<AbstractRPCConnectionEvents::StreamDataEvent>::
+                        EmitEvent(AbstractRPCConnectionEvents::StreamDataEvent(
+                            streamId, chunk, EventSender(this)), DPL::Event::EmitMode::Queued);
+                }
+                else
+                {
+                    m_inputStream.Consume(header.size - sizeof(streamId));
 
-                            LogPedantic("Ping pong replied");
-                        }
-                        break;
+                    LogPedantic("Stream " << streamId << " end parsed");
 
-                    default:
-                        LogPedantic("Warning: Unknown packet type");
-                        free(binaryPacket);
-                        break;
+                    DPL::Event::EventSupport<AbstractRPCConnectionEvents::StreamEndEvent>::
+                        EmitEvent(AbstractRPCConnectionEvents::StreamEndEvent(
+                            streamId, EventSender(this)), DPL::Event::EmitMode::Queued);
                 }
             }
-            else
+            break;
+
+        case Protocol::PacketType_Call:
+        case Protocol::PacketType_Reply:
             {
-                LogPedantic("Too few bytes to read packet");
-                break;
+                uint32_t callId;
+
+                if (header.size < sizeof(callId))
+                {
+                    LogError("Call packet without call id");
+                    OnProtocolError();
+                    return false;
+                }
+
+                m_inputStream.FlattenConsume(&callId, sizeof(callId));
+
+                BinaryQueue function;
+                ConsumeTo(m_inputStream, header.size - sizeof(callId), function);
+
+                if (header.type == Protocol::PacketType_Call)
+                {
+                    LogPedantic("Call " << callId << " of size: " <<
+                                function.Size() << " parsed");
+
+                    DPL::Event::EventSupport<AbstractRPCConnectionEvents::CallEvent>::
+                        EmitEvent(AbstractRPCConnectionEvents::CallEvent(
+                            callId, RPCFunction(function), EventSender(this)),
+                            DPL::Event::EmitMode::Queued);
+                }
+                else
+                {
+                    LogPedantic("Reply to call " << callId << " of size: " <<
+                                function.Size() << " parsed");
+
+                    PostCallCompleted(callId, RPCCallStatus::Replied,
+                                      RPCFunction(function));
+                }
             }
-        }
+            break;
+
+        default:
+            LogPedantic("Warning: Unknown packet type");
+            m_inputStream.Consume(header.size);
+            break;
+    }
+
+    return true;
+}
+
+void GenericRPCConnection::OnInputStreamRead()
+{
+    LogPedantic("Interpreting " << m_inputStream.Size() << " bytes buffer");
+
+    if (m_protocolError)
+    {
+        LogPedantic("Ignoring input after protocol error");
+        m_inputStream.Clear();
+        return;
     }
-    else
+
+    // Begin consuming as much packets as it is possible
+    while (ParsePacket())
     {
-        LogPedantic("Too few bytes to read header");
     }
 }
 
 void GenericRPCConnection::OnInputStreamClosed()
 {
+    // No reply can come anymore
+    CancelPendingCalls();
+
     // Emit closed event
     DPL::Event::EventSupport<AbstractRPCConnectionEvents::ConnectionClosedEvent>::
         EmitEvent(AbstractRPCConnectionEvents::ConnectionClosedEvent(
@@ -210,6 +570,8 @@ void GenericRPCConnection::OnInputStreamClosed()
 
 void GenericRPCConnection::OnInputStreamBroken()
 {
+    CancelPendingCalls();
+
     // Emit broken event
     DPL::Event::EventSupport<AbstractRPCConnectionEvents::ConnectionBrokenEvent>::
         EmitEvent(AbstractRPCConnectionEvents::ConnectionBrokenEvent(
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/*
+ * @file        rpc_reply_future.cpp
+ * @version     1.0
+ * @brief       This file is the implementation file of RPC reply future
+ */
+#include <dpl/rpc/rpc_reply_future.h>
+#include <dpl/assert.h>
+
+namespace DPL
+{
+namespace RPC
+{
+RPCReplyFuture::RPCReplyFuture()
+    : m_status(RPCCallStatus::Pending)
+{
+}
+
+RPCReplyFuture::~RPCReplyFuture()
+{
+}
+
+void RPCReplyFuture::Complete(RPCCallStatus::Type status,
+                              const RPCFunction &reply)
+{
+    Assert(status != RPCCallStatus::Pending);
+
+    Mutex::ScopedLock lock(&m_mutex);
+
+    // Only first completion counts
+    if (m_status != RPCCallStatus::Pending)
+        return;
+
+    m_status = status;
+    m_reply = reply;
+    m_readyEvent.Signal();
+}
+
+bool RPCReplyFuture::IsReady() const
+{
+    Mutex::ScopedLock lock(&m_mutex);
+    return m_status != RPCCallStatus::Pending;
+}
+
+RPCCallStatus::Type RPCReplyFuture::GetStatus() const
+{
+    Mutex::ScopedLock lock(&m_mutex);
+    return m_status;
+}
+
+RPCFunction RPCReplyFuture::GetReply() const
+{
+    Mutex::ScopedLock lock(&m_mutex);
+    return m_reply;
+}
+
+WaitableHandle RPCReplyFuture::GetWaitableHandle() const
+{
+    return m_readyEvent.GetHandle();
+}
+
+}
+} // namespace DPL
@@ -31,8 +31,13 @@
 #include <dpl/scoped_free.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <limits.h>
+#include <cstring>
+#include <vector>
+#include <algorithm>
 #include <dpl/assert.h>
 
 namespace DPL
@@ -103,6 +108,44 @@ private:
 
     InternalState m_internalState;
 
+    // Gathers leading buckets of binary queue for vectored write
+    class WriteVisitor
+        : public BinaryQueue::BucketVisitor
+    {
+    private:
+        std::vector<iovec> m_vectors;
+        size_t m_bytesLeft;
+
+    public:
+        explicit WriteVisitor(size_t bytes)
+            : m_bytesLeft(bytes)
+        {
+        }
+
+        virtual void OnVisitBucket(const void *buffer, size_t bufferSize)
+        {
+            if (m_bytesLeft == 0 || m_vectors.size() >= static_cast<size_t>(IOV_MAX))
+                return;
+
+            iovec vector;
+            vector.iov_base = const_cast<void *>(buffer);
+            vector.iov_len = std::min(bufferSize, m_bytesLeft);
+
+            m_vectors.push_back(vector);
+            m_bytesLeft -= vector.iov_len;
+        }
+
+        iovec *GetVectors()
+        {
+            return m_vectors.empty() ? NULL : &m_vectors[0];
+        }
+
+        size_t GetVectorCount() const
+        {
+            return m_vectors.size();
+        }
+    };
+
     void SetNonBlocking()
     {
         // Set non-blocking mode
@@ -655,16 +698,19 @@ public:
             if (bufferSize > buffer.Size())
                 bufferSize = buffer.Size();
 
-            // FIXME: User write visitor to write !
-            // WriteVisitor visitor
+            // Write buckets in place, with single call
+            WriteVisitor visitor(bufferSize);
+            buffer.VisitBuckets(&visitor);
 
-            ScopedFree<void> flattened(malloc(bufferSize));
-            buffer.Flatten(flattened.Get(), bufferSize);
+            msghdr message;
+            memset(&message, 0, sizeof(message));
+            message.msg_iov = visitor.GetVectors();
+            message.msg_iovlen = visitor.GetVectorCount();
 
             // Linux: MSG_NOSIGNAL is supported, but it is not an ideal solution
             // FIXME: Should we setup signal PIPE ignoring for whole process ?
             // In BSD, there is: setsockopt(c, SOL_SOCKET, SO_NOSIGPIPE, (void *)&on, sizeof(on))
-            ssize_t result = TEMP_FAILURE_RETRY(send(m_socket, flattened.Get(), bufferSize, MSG_NOSIGNAL));
+            ssize_t result = TEMP_FAILURE_RETRY(sendmsg(m_socket, &message, MSG_NOSIGNAL));
 
             if (result > 0)
             {
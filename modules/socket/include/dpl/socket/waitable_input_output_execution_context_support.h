@@ -45,6 +45,28 @@ public:
         DECLARE_EXCEPTION_TYPE(Base, CloseFailed)
     };
 
+    /**
+     * Output corking statistics
+     *
+     * Every corked feed would be a separate write without corking,
+     * so corkedFeeds - flushes writes were saved.
+     */
+    struct OutputCorkingStats
+    {
+        unsigned long corkedFeeds; ///< Feeds deferred by corking
+        unsigned long flushes;     ///< Writes of gathered output
+        double totalDelay;         ///< Sum of delays added by corking, in seconds
+        double maxDelay;           ///< Longest delay added by corking, in seconds
+
+        OutputCorkingStats()
+            : corkedFeeds(0),
+              flushes(0),
+              totalDelay(0.0),
+              maxDelay(0.0)
+        {
+        }
+    };
+
 private:
     bool m_opened;
     AbstractWaitableInputOutput *m_waitableInputOutput;
@@ -53,6 +75,16 @@ private:
     bool m_hasReadWatch;
     bool m_hasWriteWatch;
 
+    // Output corking state
+    bool m_corkingEnabled;
+    size_t m_corkingMaxBytes;
+    double m_corkingMaxDelay;
+    bool m_corked;
+    double m_corkedSince;
+    OutputCorkingStats m_corkingStats;
+
+    void WriteOutput();
+
     void AddReadWatch();
     void RemoveReadWatch();
     void AddWriteWatch();
@@ -78,6 +110,7 @@ protected:
     virtual void OnInputStreamBroken() = 0;
 
     // Trigger feeding output - after updating output stream
+    // With corking enabled, output may be written in next loop iteration
     void FeedOutput();
 
     // Open/Close destination waitable input-output
@@ -94,6 +127,38 @@ public:
      * Destructor
      */
     virtual ~WaitableInputOutputExecutionContextSupport();
+
+    /**
+     * Enable or disable output corking
+     *
+     * Corked output is gathered and written at once when execution
+     * context gets back to its event loop, or earlier when more than
+     * @a maxBytes are gathered or the oldest data waits longer than
+     * @a maxDelay seconds. Disabling corking flushes gathered output.
+     *
+     * @param[in] enabled True to enable corking
+     * @param[in] maxBytes Byte budget of gathered output
+     * @param[in] maxDelay Latency budget of gathered output in seconds
+     * @return none
+     */
+    void SetOutputCorking(bool enabled,
+                          size_t maxBytes = 64 * 1024,
+                          double maxDelay = 0.01);
+
+    /**
+     * @return Output corking statistics
+     */
+    OutputCorkingStats GetOutputCorkingStats() const;
+
+    /**
+     * Write gathered output immediately instead of waiting for next loop
+     * iteration. Without corking output is never gathered and flushing
+     * is not needed.
+     *
+     * @return none
+     * @exception Exception::NotOpened Input-output is not opened
+     */
+    void FlushOutput();
 };
 
 }
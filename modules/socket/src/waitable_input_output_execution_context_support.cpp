@@ -24,6 +24,7 @@
 #include <dpl/socket/abstract_socket.h> // FIXME: Remove !!!
 #include <dpl/log/log.h>
 #include <dpl/assert.h>
+#include <dpl/monotonic_time.h>
 
 namespace DPL
 {
@@ -39,7 +40,12 @@ WaitableInputOutputExecutionContextSupport::WaitableInputOutputExecutionContextS
     : m_opened(false),
       m_waitableInputOutput(NULL),
       m_hasReadWatch(false),
-      m_hasWriteWatch(false)
+      m_hasWriteWatch(false),
+      m_corkingEnabled(false),
+      m_corkingMaxBytes(0),
+      m_corkingMaxDelay(0.0),
+      m_corked(false),
+      m_corkedSince(0.0)
 {
 }
 
@@ -78,6 +84,10 @@ void WaitableInputOutputExecutionContextSupport::Close()
 
     LogPedantic("Closing waitable input-output execution context support...");
 
+    // Do not lose gathered output
+    if (m_corked)
+        WriteOutput();
+
     // Remove read and write watches
     CheckedRemoveReadWriteWatch();
 
@@ -153,7 +163,7 @@ void WaitableInputOutputExecutionContextSupport::OnWaitableHandleEvent(WaitableH
             LogPedantic("Write event occurred");
 
             // Push bytes and unregister from write event
-            FeedOutput();
+            WriteOutput();
 
             // Unregister write watch only if no more data is available
             if (m_outputStream.Empty())
@@ -231,11 +241,86 @@ void WaitableInputOutputExecutionContextSupport::ReadInput()
     OnInputStreamRead();
 }
 
+void WaitableInputOutputExecutionContextSupport::SetOutputCorking(bool enabled,
+                                                                  size_t maxBytes,
+                                                                  double maxDelay)
+{
+    LogPedantic("Output corking " << (enabled ? "enabled" : "disabled"));
+
+    m_corkingEnabled = enabled;
+    m_corkingMaxBytes = maxBytes;
+    m_corkingMaxDelay = maxDelay;
+
+    if (!enabled && m_opened)
+        WriteOutput();
+}
+
+WaitableInputOutputExecutionContextSupport::OutputCorkingStats
+WaitableInputOutputExecutionContextSupport::GetOutputCorkingStats() const
+{
+    return m_corkingStats;
+}
+
 void WaitableInputOutputExecutionContextSupport::FeedOutput()
 {
     if (!m_opened)
         Throw(Exception::NotOpened);
 
+    // Anything to feed ?
+    if (m_outputStream.Empty())
+        return;
+
+    if (m_corkingEnabled && m_outputStream.Size() < m_corkingMaxBytes)
+    {
+        double now = DPL::GetMonotonicTime() / 1e6;
+
+        if (!m_corked)
+        {
+            m_corked = true;
+            m_corkedSince = now;
+        }
+
+        if (now - m_corkedSince < m_corkingMaxDelay)
+        {
+            ++m_corkingStats.corkedFeeds;
+
+            // Output is writable, so write watch fires in next loop iteration
+            if (!m_hasWriteWatch)
+            {
+                AddWriteWatch();
+                m_hasWriteWatch = true;
+            }
+
+            LogPedantic("Corked " << m_outputStream.Size() << " output bytes");
+            return;
+        }
+    }
+
+    WriteOutput();
+}
+
+void WaitableInputOutputExecutionContextSupport::FlushOutput()
+{
+    if (!m_opened)
+        Throw(Exception::NotOpened);
+
+    WriteOutput();
+}
+
+void WaitableInputOutputExecutionContextSupport::WriteOutput()
+{
+    if (m_corked)
+    {
+        double delay = DPL::GetMonotonicTime() / 1e6 - m_corkedSince;
+
+        m_corked = false;
+        ++m_corkingStats.flushes;
+        m_corkingStats.totalDelay += delay;
+
+        if (delay > m_corkingStats.maxDelay)
+            m_corkingStats.maxDelay = delay;
+    }
+
     // Anything to feed ?
     if (m_outputStream.Empty())
         return;
@@ -18,11 +18,20 @@
 
 #include <dpl/db/thread_database_support.h>
 #include <dpl/db/sql_connection.h>
+#include <dpl/foreach.h>
 #include <dpl/mutex.h>
 #include <dpl/thread.h>
 #include <dpl/wrt-dao-ro/global_config.h>
+#include <dpl/wrt-dao-ro/webruntime_database.h>
+#include <dpl/db/orm.h>
+#include <orm_generator_wrt.h>
+#include <cstdlib>
 
 namespace WrtDB {
+namespace {
+const char *PROFILING_ENV_NAME = "WRT_DB_PROFILING";
+const char *ARGUMENT_LOGGING_ENV_NAME = "WRT_DB_PROFILING_ARGUMENTS";
+} // namespace
 
 const char* WrtDatabase::Address()
 {
@@ -32,7 +41,23 @@ const char* WrtDatabase::Address()
 
 DPL::DB::SqlConnection::Flag::Type WrtDatabase::Flags()
 {
-    return DPL::DB::SqlConnection::Flag::UseLucene;
+    int flags = DPL::DB::SqlConnection::Flag::UseLucene |
+                DPL::DB::SqlConnection::Flag::UseWAL |
+                DPL::DB::SqlConnection::Flag::UseMmap |
+                DPL::DB::SqlConnection::Flag::UseMemoryTempStore;
+
+    // Statement statistics and slow query log for diagnostics
+    if (getenv(PROFILING_ENV_NAME)) {
+        flags |= DPL::DB::SqlConnection::Flag::UseProfiling;
+    }
+
+    // Slow query arguments may hold private data, values are logged on
+    // explicit request only
+    if (getenv(ARGUMENT_LOGGING_ENV_NAME)) {
+        flags |= DPL::DB::SqlConnection::Flag::UseArgumentLogging;
+    }
+
+    return static_cast<DPL::DB::SqlConnection::Flag::Type>(flags);
 }
 
 DPL::DB::ThreadDatabaseSupport WrtDatabase::m_interface(
@@ -64,4 +89,43 @@ bool WrtDatabase::CheckTableExist(const char *name)
     return m_interface.CheckTableExist(name);
 }
 
+DPL::DB::SqlConnection::DataVersion WrtDatabase::GetDataVersion()
+{
+    return m_interface.GetDataVersion();
+}
+
+int WrtDatabase::GetTableVersion(const char *name)
+{
+    using namespace DPL::DB::ORM;
+    using namespace DPL::DB::ORM::wrt;
+    WRT_DB_SELECT(select, TableVersions, &m_interface)
+    select->Where(Equals<TableVersions::name>(DPL::FromASCIIString(name)));
+
+    std::list<TableVersions::version::ColumnType> versions =
+        select->GetValueList<TableVersions::version>();
+
+    if (versions.empty()) {
+        return 0;
+    }
+    return versions.front();
+}
+
+int WrtDatabase::GetTablesVersion(const std::set<DPL::String> &names)
+{
+    using namespace DPL::DB::ORM;
+    using namespace DPL::DB::ORM::wrt;
+    WRT_DB_SELECT(select, TableVersions, &m_interface)
+    select->Where(In<TableVersions::name>(names));
+
+    std::list<TableVersions::version::ColumnType> versions =
+        select->GetValueList<TableVersions::version>();
+
+    // Versions only grow, so their sum changes on every tracked write
+    int result = 0;
+    FOREACH(it, versions) {
+        result += *it;
+    }
+    return result;
+}
+
 }
@@ -72,17 +72,20 @@ FeatureHandle RegisterFeature(const PluginMetafileData::Feature &feature,
         {
             int deviceCapID;
 
-            if (FeatureDAOReadOnly::isDeviceCapabilityInstalled(*itdev)) {
-                LogInfo("    |    |--DeviceCap " << *itdev <<
-                        " already installed!");
+            // Queried directly, shared feature catalog does not see
+            // uncommitted data of this transaction
+            WRT_DB_SELECT(select, DeviceCapabilities, &WrtDatabase::interface())
+            select->Where(Equals<DeviceCapabilities::DeviceCapName>(
+                              DPL::FromUTF8String(*itdev)));
 
-                WRT_DB_SELECT(select, DeviceCapabilities, &WrtDatabase::interface())
+            std::list<int> deviceCapIDs =
+                select->GetValueList<DeviceCapabilities::DeviceCapID>();
 
-                select->Where(Equals<DeviceCapabilities::DeviceCapName>(
-                                  DPL::FromUTF8String(*itdev)));
+            if (!deviceCapIDs.empty()) {
+                LogInfo("    |    |--DeviceCap " << *itdev <<
+                        " already installed!");
 
-                deviceCapID =
-                    select->GetSingleValue<DeviceCapabilities::DeviceCapID>();
+                deviceCapID = deviceCapIDs.front();
             } else {
                 LogInfo("    |    |--Register DeviceCap: " << *itdev);
 
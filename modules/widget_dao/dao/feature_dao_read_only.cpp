@@ -24,6 +24,8 @@
 #include <sstream>
 #include <dpl/log/log.h>
 #include <dpl/foreach.h>
+#include <dpl/mutex.h>
+#include <dpl/scoped_ptr.h>
 #include <dpl/db/orm.h>
 #include <orm_generator_wrt.h>
 #include <dpl/wrt-dao-ro/webruntime_database.h>
@@ -31,6 +33,67 @@
 
 namespace WrtDB {
 
+namespace {
+// Catalog is shared by all threads and replaced when feature tables change
+DPL::Mutex g_featureCatalogMutex;
+FeatureCatalogPtr g_featureCatalog;
+
+std::set<DPL::String> getFeatureTableNames()
+{
+    std::set<DPL::String> names;
+    names.insert(L"FeaturesList");
+    names.insert(L"DeviceCapabilities");
+    names.insert(L"FeatureDeviceCapProxy");
+    return names;
+}
+} // namespace
+
+FeatureCatalog::FeatureCatalog(int version) :
+    m_version(version)
+{
+}
+
+int FeatureCatalog::getVersion() const
+{
+    return m_version;
+}
+
+const FeatureDAOReadOnly::NameMap& FeatureCatalog::getNames() const
+{
+    return m_names;
+}
+
+const FeatureDAOReadOnly::DeviceCapabilitiesMap&
+FeatureCatalog::getDevCapWithFeatureHandle() const
+{
+    return m_devCaps;
+}
+
+const FeatureDAOReadOnly::DeviceCapabilitiesList&
+FeatureCatalog::getDeviceCapabilities(FeatureHandle handle) const
+{
+    static const FeatureDAOReadOnly::DeviceCapabilitiesList empty;
+
+    DeviceCapabilitiesIndex::const_iterator it = m_featureDevCaps.find(handle);
+    return it != m_featureDevCaps.end() ? it->second : empty;
+}
+
+bool FeatureCatalog::isFeatureInstalled(const std::string &featureName) const
+{
+    return m_handles.find(featureName) != m_handles.end();
+}
+
+bool FeatureCatalog::isFeatureInstalled(FeatureHandle handle) const
+{
+    return m_featureDevCaps.find(handle) != m_featureDevCaps.end();
+}
+
+bool FeatureCatalog::isDeviceCapabilityInstalled(
+        const std::string &deviceCapName) const
+{
+    return m_installedDevCaps.find(deviceCapName) != m_installedDevCaps.end();
+}
+
 FeatureDAOReadOnly::FeatureDAOReadOnly(FeatureHandle featureHandle) :
     m_featureHandle(featureHandle)
 {
@@ -162,6 +225,17 @@ FeatureHandleList FeatureDAOReadOnly::GetHandleList()
 bool FeatureDAOReadOnly::isFeatureInstalled(const std::string &featureName)
 {
     LogDebug("Check if Feature is installed. Name: " << featureName);
+
+    // Catalog loaded inside transaction which registers features is not
+    // shared and would be reloaded after every change, query is cheaper
+    if (!WrtDatabase::interface().IsInTransaction()) {
+        bool flag = GetFeatureCatalog()->isFeatureInstalled(featureName);
+        LogDebug(" >> Feature " << featureName <<
+                 (flag ? " found." : " not found."));
+
+        return flag;
+    }
+
     Try {
         using namespace DPL::DB::ORM;
         using namespace DPL::DB::ORM::wrt;
@@ -169,9 +243,7 @@ bool FeatureDAOReadOnly::isFeatureInstalled(const std::string &featureName)
         select->Where(Equals<FeaturesList::FeatureName>(
                           DPL::FromUTF8String(featureName)));
 
-        FeaturesList::Select::RowList rows = select->GetRowList();
-
-        bool flag = !rows.empty();
+        bool flag = select->Exists();
         LogDebug(" >> Feature " << featureName <<
                  (flag ? " found." : " not found."));
 
@@ -186,6 +258,15 @@ bool FeatureDAOReadOnly::isFeatureInstalled(const std::string &featureName)
 bool FeatureDAOReadOnly::isFeatureInstalled(FeatureHandle handle)
 {
     LogDebug("Check if Feature is installed. Handle: " << handle);
+
+    if (!WrtDatabase::interface().IsInTransaction()) {
+        bool flag = GetFeatureCatalog()->isFeatureInstalled(handle);
+        LogDebug(" >> Feature " << handle <<
+                 (flag ? " found." : " not found."));
+
+        return flag;
+    }
+
     Try
     {
         using namespace DPL::DB::ORM;
@@ -193,9 +274,7 @@ bool FeatureDAOReadOnly::isFeatureInstalled(FeatureHandle handle)
         WRT_DB_SELECT(select, FeaturesList, &WrtDatabase::interface())
         select->Where(Equals<FeaturesList::FeatureUUID>(handle));
 
-        FeaturesList::Select::RowList rows = select->GetRowList();
-
-        bool flag = !rows.empty();
+        bool flag = select->Exists();
         LogDebug(" >> Feature " << handle <<
                  (flag ? " found." : " not found."));
 
@@ -211,62 +290,20 @@ bool FeatureDAOReadOnly::isDeviceCapabilityInstalled(
         const std::string &deviceCapName)
 {
     LogDebug("Check if DeviceCap is installed. Name: " << deviceCapName);
-    Try {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, DeviceCapabilities, &WrtDatabase::interface())
-        select->Where(Equals<DeviceCapabilities::DeviceCapName>(
-                          DPL::FromUTF8String(deviceCapName)));
-
-        DeviceCapabilities::Select::RowList rows = select->GetRowList();
 
-        bool flag = !rows.empty();
-        LogDebug(" >> Device Cap " << deviceCapName <<
-                 (flag ? "found." : "not found."));
+    bool flag = GetFeatureCatalog()->isDeviceCapabilityInstalled(deviceCapName);
+    LogDebug(" >> Device Cap " << deviceCapName <<
+             (flag ? "found." : "not found."));
 
-        return flag;
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(FeatureDAOReadOnly::Exception::DatabaseError,
-                   "Failure during checking if DeviceCap is installed");
-    }
+    return flag;
 }
 
 FeatureDAOReadOnly::DeviceCapabilitiesList
 FeatureDAOReadOnly::GetDeviceCapabilities() const
 {
-    Try {
-        LogDebug("Get DeviceCap. FeatureHandle: " << m_featureHandle);
-        DPL::DB::ORM::wrt::ScopedTransaction transaction(&WrtDatabase::interface());
-
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(selectDevCP, FeatureDeviceCapProxy, &WrtDatabase::interface())
-        selectDevCP->Where(Equals<FeatureDeviceCapProxy::FeatureUUID>(
-                               m_featureHandle));
-
-        DeviceCapabilitiesList devCap;
-
-        std::list<int> deviceIDs =
-            selectDevCP->GetValueList<FeatureDeviceCapProxy::DeviceCapID>();
-        FOREACH(devCId, deviceIDs)
-        {
-            WRT_DB_SELECT(selectDevC, DeviceCapabilities, &WrtDatabase::interface())
-            selectDevC->Where(Equals<DeviceCapabilities::DeviceCapID>(*devCId));
-
-            DPL::String devNames =
-                selectDevC->GetSingleValue<DeviceCapabilities::DeviceCapName>();
-
-            devCap.insert(DPL::ToUTF8String(devNames));
-        }
+    LogDebug("Get DeviceCap. FeatureHandle: " << m_featureHandle);
 
-        transaction.Commit();
-        return devCap;
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(FeatureDAOReadOnly::Exception::DatabaseError,
-                   "Failure during getting DeviceCapabilities names");
-    }
+    return GetFeatureCatalog()->getDeviceCapabilities(m_featureHandle);
 }
 
 FeatureHandleListPtr FeatureDAOReadOnly::GetFeatureHandleListForPlugin(
@@ -302,57 +339,117 @@ FeatureHandleListPtr FeatureDAOReadOnly::GetFeatureHandleListForPlugin(
 FeatureDAOReadOnly::NameMap
 FeatureDAOReadOnly::GetNames()
 {
-    Try {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, FeaturesList, &WrtDatabase::interface())
-
-        NameMap nameMap;
-
-        FeaturesList::Select::RowList rows = select->GetRowList();
-        FOREACH(rowIt, rows)
-        {
-            nameMap.insert(std::pair<FeatureHandle, std::string>(rowIt->Get_FeatureUUID(), DPL::ToUTF8String(rowIt->Get_FeatureName())));
-        }
-
-        return nameMap;
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(FeatureDAOReadOnly::Exception::DatabaseError,
-                   "Failure during getting GetNames");
-    }
+    return GetFeatureCatalog()->getNames();
 }
 
 FeatureDAOReadOnly::DeviceCapabilitiesMap
 FeatureDAOReadOnly::GetDevCapWithFeatureHandle()
+{
+    return GetFeatureCatalog()->getDevCapWithFeatureHandle();
+}
+
+FeatureCatalogPtr FeatureDAOReadOnly::GetFeatureCatalog()
 {
     Try {
+        std::set<DPL::String> tableNames = getFeatureTableNames();
+        int version = WrtDatabase::GetTablesVersion(tableNames);
+
+        {
+            DPL::Mutex::ScopedLock catalogLock(&g_featureCatalogMutex);
+
+            if (!!g_featureCatalog &&
+                g_featureCatalog->getVersion() == version)
+            {
+                return g_featureCatalog;
+            }
+        }
+
+        // Catalog is loaded without mutex, so that readers of current
+        // catalog are not blocked by database access
         using namespace DPL::DB::ORM;
         using namespace DPL::DB::ORM::wrt;
 
-        DECLARE_COLUMN_TYPE_LIST()
-        SELECTED_COLUMN(FeatureDeviceCapProxy, FeatureUUID)
-        SELECTED_COLUMN(DeviceCapabilities, DeviceCapName)
-        DECLARE_COLUMN_TYPE_LIST_END(DevCapNameList)
+        // Caller's transaction may hold uncommitted feature data, which
+        // cannot be shared with other threads
+        bool shared = !WrtDatabase::interface().IsInTransaction();
+
+        // Version is read again in transaction, so that it matches data
+        ScopedTransaction transaction(&WrtDatabase::interface());
+        version = WrtDatabase::GetTablesVersion(tableNames);
+
+        LogDebug("Loading feature catalog. Version: " << version);
+
+        DPL::ScopedPtr<FeatureCatalog> catalog(new FeatureCatalog(version));
 
-        WRT_DB_SELECT(select, FeatureDeviceCapProxy, &WrtDatabase::interface())
-        select->Join<DevCapNameList>(Equal<FeatureDeviceCapProxy::DeviceCapID, DeviceCapabilities::DeviceCapID>());
+        {
+            WRT_DB_SELECT(select, FeaturesList, &WrtDatabase::interface())
+            FeaturesList::Select::RowList rows = select->GetRowList();
+
+            FOREACH(rowIt, rows)
+            {
+                std::string name = DPL::ToUTF8String(rowIt->Get_FeatureName());
+                catalog->m_names.insert(std::pair<FeatureHandle, std::string>(
+                    rowIt->Get_FeatureUUID(), name));
+                catalog->m_handles[name] = rowIt->Get_FeatureUUID();
+                catalog->m_featureDevCaps[rowIt->Get_FeatureUUID()];
+            }
+        }
 
-        DeviceCapabilitiesMap devCap;
+        std::map<int, std::string> devCapNames;
 
-        std::list< CustomRow<DevCapNameList> > rowList = select->GetCustomRowList< DevCapNameList, CustomRow<DevCapNameList> >();
-        FOREACH(rowIt, rowList)
         {
-            FeatureHandle featureHandle = (*rowIt).GetColumnData<FeatureDeviceCapProxy::FeatureUUID>();
-            std::string devName = DPL::ToUTF8String((*rowIt).GetColumnData<DeviceCapabilities::DeviceCapName>());
-            devCap.insert(std::pair<FeatureHandle, std::string>(featureHandle, devName));
+            WRT_DB_SELECT(select, DeviceCapabilities, &WrtDatabase::interface())
+            DeviceCapabilities::Select::RowList rows = select->GetRowList();
+
+            FOREACH(rowIt, rows)
+            {
+                std::string devName =
+                    DPL::ToUTF8String(rowIt->Get_DeviceCapName());
+                devCapNames[rowIt->Get_DeviceCapID()] = devName;
+                catalog->m_installedDevCaps.insert(devName);
+            }
+        }
+
+        {
+            WRT_DB_SELECT(select, FeatureDeviceCapProxy,
+                          &WrtDatabase::interface())
+            FeatureDeviceCapProxy::Select::RowList rows = select->GetRowList();
+
+            FOREACH(rowIt, rows)
+            {
+                std::map<int, std::string>::const_iterator devName =
+                    devCapNames.find(rowIt->Get_DeviceCapID());
+
+                if (devName != devCapNames.end()) {
+                    catalog->m_devCaps.insert(
+                        std::pair<FeatureHandle, std::string>(
+                            rowIt->Get_FeatureUUID(), devName->second));
+                    catalog->m_featureDevCaps[rowIt->Get_FeatureUUID()].insert(
+                        devName->second);
+                }
+            }
+        }
+
+        transaction.Commit();
+
+        FeatureCatalogPtr result(catalog.Release());
+
+        if (!shared) {
+            return result;
+        }
+
+        DPL::Mutex::ScopedLock catalogLock(&g_featureCatalogMutex);
+
+        // Other thread may have stored newer catalog meanwhile
+        if (!g_featureCatalog || g_featureCatalog->getVersion() <= version) {
+            g_featureCatalog = result;
         }
 
-        return devCap;
+        return result;
     }
     Catch(DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(FeatureDAOReadOnly::Exception::DatabaseError,
-                   "Failure during getting DeviceCapabilities names");
+                   "Failure during loading feature catalog");
     }
 }
 
@@ -41,6 +41,7 @@ void GlobalDAO::SetDeveloperMode(bool mode)
         WRT_DB_UPDATE(update, GlobalProperties, &WrtDatabase::interface())
         update->Values(row);
         update->Execute();
+        RefreshSettings();
     }
     Catch(DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(GlobalDAO::Exception::DatabaseError,
@@ -59,6 +60,7 @@ void GlobalDAO::SetSecureByDefault(bool secure)
         WRT_DB_UPDATE(update, GlobalProperties, &WrtDatabase::interface())
         update->Values(row);
         update->Execute();
+        RefreshSettings();
     }
     Catch(DPL::DB::SqlConnection::Exception::Base) {
         ReThrowMsg(GlobalDAO::Exception::DatabaseError,
@@ -77,6 +79,7 @@ void GlobalDAO::setComplianceMode(bool mode)
         WRT_DB_UPDATE(update, GlobalProperties, &WrtDatabase::interface())
         update->Values(row);
         update->Execute();
+        RefreshSettings();
     }
     Catch (DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(GlobalDAO::Exception::DatabaseError,
@@ -95,6 +98,7 @@ void GlobalDAO::setComplianceFakeImei(const std::string &imei)
         WRT_DB_UPDATE(update, GlobalProperties, &WrtDatabase::interface())
         update->Values(row);
         update->Execute();
+        RefreshSettings();
     }
     Catch (DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(GlobalDAO::Exception::DatabaseError,
@@ -113,6 +117,7 @@ void GlobalDAO::setComplianceFakeMeid(const std::string &meid)
         WRT_DB_UPDATE(update, GlobalProperties, &WrtDatabase::interface())
         update->Values(row);
         update->Execute();
+        RefreshSettings();
     }
     Catch (DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(GlobalDAO::Exception::DatabaseError,
@@ -132,6 +137,7 @@ void GlobalDAO::SetHomeNetworkDataUsage(GlobalDAO::NetworkAccessMode newMode)
         WRT_DB_UPDATE(update, GlobalProperties, &WrtDatabase::interface())
         update->Values(row);
         update->Execute();
+        RefreshSettings();
     }
     Catch(DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(GlobalDAO::Exception::DatabaseError,
@@ -151,6 +157,7 @@ void GlobalDAO::SetRoamingDataUsage(GlobalDAO::NetworkAccessMode newMode)
         WRT_DB_UPDATE(update, GlobalProperties, &WrtDatabase::interface())
         update->Values(row);
         update->Execute();
+        RefreshSettings();
     }
     Catch(DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(GlobalDAO::Exception::DatabaseError,
@@ -209,6 +216,7 @@ void GlobalDAO::SetCookieSharingMode(bool mode)
         WRT_DB_UPDATE(update, GlobalProperties, &WrtDatabase::interface())
         update->Values(row);
         update->Execute();
+        RefreshSettings();
     }
     Catch(DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(GlobalDAO::Exception::DatabaseError,
@@ -22,8 +22,16 @@
 
 #include <dpl/wrt-dao-ro/global_dao_read_only.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
 #include <dpl/foreach.h>
 #include <dpl/log/log.h>
+#include <dpl/monotonic_time.h>
+#include <dpl/mutex.h>
+#include <dpl/once.h>
 #include <dpl/string.h>
 #include <dpl/db/orm.h>
 #include <orm_generator_wrt.h>
@@ -33,129 +41,234 @@
 
 namespace WrtDB {
 
-bool GlobalDAOReadOnly::GetDeveloperMode()
+namespace {
+// IANA subtag registry is static data. It is loaded once into a sorted
+// array, so validating language tags does not touch database.
+typedef std::pair<DPL::String, int> SubTagRecord;
+typedef std::vector<SubTagRecord> SubTagIndex;
+
+// Index is never modified after it is loaded, lookups do not lock
+DPL::Once g_subTagIndexOnce;
+SubTagIndex g_subTagIndex;
+
+bool CompareSubTag(const SubTagRecord &first, const SubTagRecord &second)
 {
-    LogDebug("Getting Developer mode");
-    Try {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, GlobalProperties, &WrtDatabase::interface())
-        return select->GetSingleValue<GlobalProperties::developer_mode>();
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(GlobalDAOReadOnly::Exception::DatabaseError,
-                   "Failed to get developer mode");
+    return first.first < second.first;
+}
+
+// Lookup compares with the tag directly, no record is built for it
+bool IsSubTagLess(const SubTagRecord &record, const DPL::String &tag)
+{
+    return record.first < tag;
+}
+
+bool IsSameSubTag(const SubTagRecord &first, const SubTagRecord &second)
+{
+    return first.first == second.first;
+}
+
+void LoadSubTagIndex()
+{
+    using namespace DPL::DB::ORM;
+    using namespace DPL::DB::ORM::wrt;
+
+    LogDebug("Loading IANA subtag index");
+
+    DECLARE_COLUMN_TYPE_LIST()
+    SELECTED_COLUMN(iana_records, SUBTAG)
+    SELECTED_COLUMN(iana_records, TYPE)
+    DECLARE_COLUMN_TYPE_LIST_END(SubTagColumnList)
+
+    typedef std::list<CustomRow<SubTagColumnList> > SubTagRowList;
+
+    WRT_DB_SELECT(select, iana_records, &WrtDatabase::interface())
+    SubTagRowList rows = select->GetCustomRowList<
+            SubTagColumnList, CustomRow<SubTagColumnList> >();
+
+    SubTagIndex index;
+    index.reserve(rows.size());
+
+    FOREACH(it, rows) {
+        DPL::Optional<DPL::String> subTag =
+            it->GetColumnData<iana_records::SUBTAG>();
+
+        if (!subTag.IsNull()) {
+            index.push_back(SubTagRecord(
+                                *subTag,
+                                it->GetColumnData<iana_records::TYPE>()));
+        }
     }
+
+    // First record of duplicated subtag wins, as with database lookup
+    std::stable_sort(index.begin(), index.end(), CompareSubTag);
+    index.erase(std::unique(index.begin(), index.end(), IsSameSubTag),
+                index.end());
+
+    g_subTagIndex.swap(index);
 }
 
-bool GlobalDAOReadOnly::GetSecureByDefault()
+// Settings are read on every network request. GlobalProperties row is
+// cached, and its version is checked at most once per interval to notice
+// changes made by other processes.
+const uint64_t SETTINGS_CHECK_INTERVAL = 1000000; // [us]
+
+DPL::Mutex g_settingsMutex;
+GlobalDAOReadOnly::Settings g_settings;
+bool g_settingsLoaded = false;
+int g_settingsVersion = 0;
+uint64_t g_settingsCheckTime = 0;
+unsigned long g_settingsRefreshCount = 0;
+
+GlobalDAOReadOnly::Settings LoadSettings()
 {
     using namespace DPL::DB::ORM;
     using namespace DPL::DB::ORM::wrt;
+
     WRT_DB_SELECT(select, GlobalProperties, &WrtDatabase::interface())
-    return select->GetSingleValue<GlobalProperties::secure_by_default>();
+    GlobalProperties::Row row = select->GetSingleRow();
+
+    GlobalDAOReadOnly::Settings settings;
+    settings.developerMode = row.Get_developer_mode();
+    settings.secureByDefault = row.Get_secure_by_default();
+    settings.complianceMode = row.Get_compliance_mode();
+    settings.complianceFakeImei =
+        DPL::ToUTF8String(row.Get_compliance_fake_imei());
+    settings.complianceFakeMeid =
+        DPL::ToUTF8String(row.Get_compliance_fake_meid());
+    settings.homeNetworkDataUsage =
+        static_cast<GlobalDAOReadOnly::NetworkAccessMode>(
+            row.Get_home_network_data_usage());
+    settings.roamingDataUsage =
+        static_cast<GlobalDAOReadOnly::NetworkAccessMode>(
+            row.Get_roaming_data_usage());
+    settings.cookieSharingMode = row.Get_cookie_sharing_mode();
+    return settings;
+}
+} // namespace
+
+bool GlobalDAOReadOnly::GetDeveloperMode()
+{
+    LogDebug("Getting Developer mode");
+    return GetSettings().developerMode;
+}
+
+bool GlobalDAOReadOnly::GetSecureByDefault()
+{
+    return GetSettings().secureByDefault;
 }
 
 bool GlobalDAOReadOnly::getComplianceMode()
 {
     LogDebug("Getting compliance mode");
-    Try{
-        using namespace DPL::DB::ORM; using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, GlobalProperties, &WrtDatabase::interface())
-        return select->GetSingleValue<GlobalProperties::compliance_mode>();
-    }
-    Catch (DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(GlobalDAOReadOnly::Exception::DatabaseError,
-                   "Failed to get compliance mode");
-    }
+    return GetSettings().complianceMode;
 }
 
 std::string GlobalDAOReadOnly::getComplianceFakeImei()
 {
     LogDebug("Getting compliance fake IMEI");
-    Try{
-        using namespace DPL::DB::ORM; using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, GlobalProperties, &WrtDatabase::interface())
-        DPL::Optional<DPL::String> result =
-            select->GetSingleValue<GlobalProperties::compliance_fake_imei>();
-        if (!result) {
-            return std::string();
-        }
-        return DPL::ToUTF8String(*result);
-    }
-    Catch (DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(GlobalDAOReadOnly::Exception::DatabaseError,
-                   "Failed to get compliance fake IMEI");
-    }
+    return GetSettings().complianceFakeImei;
 }
 
 std::string GlobalDAOReadOnly::getComplianceFakeMeid()
 {
     LogDebug("Getting compliance fake MEID");
-    Try{
-        using namespace DPL::DB::ORM; using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, GlobalProperties, &WrtDatabase::interface())
-        DPL::Optional<DPL::String> result =
-            select->GetSingleValue<GlobalProperties::compliance_fake_meid>();
-        if (!result) {
-            return std::string();
-        }
-        return DPL::ToUTF8String(*result);
-    }
-    Catch (DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(GlobalDAOReadOnly::Exception::DatabaseError,
-                   "Failed to get compliance fake MEID");
-    }
+    return GetSettings().complianceFakeMeid;
 }
 
 bool GlobalDAOReadOnly::IsValidSubTag(const DPL::String& tag, int type)
 {
-    using namespace DPL::DB::ORM;
-    using namespace DPL::DB::ORM::wrt;
-    WRT_DB_SELECT(select, iana_records, &WrtDatabase::interface())
-    select->Where(Equals<iana_records::SUBTAG>(tag));
-    auto row = select->GetRowList();
-    if (row.size() == 0 || row.front().Get_TYPE() != type) {
-        return false;
-    } else {
-        return true;
-    }
+    g_subTagIndexOnce.Call(DPL::Once::Delegate(&LoadSubTagIndex));
+
+    SubTagIndex::const_iterator it =
+        std::lower_bound(g_subTagIndex.begin(),
+                         g_subTagIndex.end(),
+                         tag,
+                         IsSubTagLess);
+
+    return it != g_subTagIndex.end() && it->first == tag &&
+           it->second == type;
 }
 
 GlobalDAOReadOnly::NetworkAccessMode
         GlobalDAOReadOnly::GetHomeNetworkDataUsage()
 {
     LogDebug("Getting home network data usage");
-    Try {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, GlobalProperties, &WrtDatabase::interface())
-        return static_cast<GlobalDAOReadOnly::NetworkAccessMode>(
-            select->GetSingleValue<
-            GlobalProperties::home_network_data_usage>());
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(GlobalDAOReadOnly::Exception::DatabaseError,
-                   "Failed to get home network data usage");
-    }
+    return GetSettings().homeNetworkDataUsage;
 }
 
 GlobalDAOReadOnly::NetworkAccessMode GlobalDAOReadOnly::GetRoamingDataUsage()
 {
     LogDebug("Getting roaming network data usage");
+    return GetSettings().roamingDataUsage;
+}
+
+GlobalDAOReadOnly::Settings GlobalDAOReadOnly::GetSettings()
+{
     Try {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, GlobalProperties, &WrtDatabase::interface())
-        return static_cast<GlobalDAOReadOnly::NetworkAccessMode>(
-            select->GetSingleValue<GlobalProperties::roaming_data_usage>());
+        // Caller's transaction may hold uncommitted settings
+        if (WrtDatabase::interface().IsInTransaction()) {
+            return LoadSettings();
+        }
+
+        unsigned long refreshCount;
+
+        {
+            DPL::Mutex::ScopedLock lock(&g_settingsMutex);
+
+            if (g_settingsLoaded && DPL::GetMonotonicTime() -
+                g_settingsCheckTime < SETTINGS_CHECK_INTERVAL)
+            {
+                return g_settings;
+            }
+
+            refreshCount = g_settingsRefreshCount;
+        }
+
+        // Version is checked and settings are loaded without mutex, so that
+        // readers of current settings are not blocked by database access
+        uint64_t now = DPL::GetMonotonicTime();
+        int version = WrtDatabase::GetTableVersion("GlobalProperties");
+
+        {
+            DPL::Mutex::ScopedLock lock(&g_settingsMutex);
+
+            if (g_settingsLoaded && version == g_settingsVersion) {
+                g_settingsCheckTime = now;
+                return g_settings;
+            }
+        }
+
+        LogDebug("Loading global settings. Version: " << version);
+        GlobalDAOReadOnly::Settings settings = LoadSettings();
+
+        DPL::Mutex::ScopedLock lock(&g_settingsMutex);
+
+        // Other thread may have stored newer settings meanwhile, and
+        // settings loaded before RefreshSettings call must not be stored
+        if (refreshCount == g_settingsRefreshCount &&
+            (!g_settingsLoaded || version >= g_settingsVersion))
+        {
+            g_settings = settings;
+            g_settingsVersion = version;
+            g_settingsLoaded = true;
+            g_settingsCheckTime = now;
+        }
+
+        return settings;
     }
     Catch(DPL::DB::SqlConnection::Exception::Base){
         ReThrowMsg(GlobalDAOReadOnly::Exception::DatabaseError,
-                   "Failed to get roaming network data usage");
+                   "Failed to get global settings");
     }
 }
 
+void GlobalDAOReadOnly::RefreshSettings()
+{
+    DPL::Mutex::ScopedLock lock(&g_settingsMutex);
+    g_settingsLoaded = false;
+    ++g_settingsRefreshCount;
+}
+
 //user agent strings are stored in db...
 //and it is configurable for test in development.
 DPL::String GlobalDAOReadOnly::GetUserAgentValue(const DPL::String &key)
@@ -250,16 +363,7 @@ WidgetAccessInfoList GlobalDAOReadOnly::GetWhiteURIList()
 bool GlobalDAOReadOnly::GetCookieSharingMode()
 {
     LogDebug("Getting Cookie Sharing mode");
-    Try {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        WRT_DB_SELECT(select, GlobalProperties, &WrtDatabase::interface())
-        return select->GetSingleValue<GlobalProperties::cookie_sharing_mode>();
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(GlobalDAOReadOnly::Exception::DatabaseError,
-                   "Failed to get Cookie Sharing mode");
-    }
+    return GetSettings().cookieSharingMode;
 }
 
 } // namespace WrtDB
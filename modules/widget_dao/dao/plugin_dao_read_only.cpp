@@ -23,8 +23,11 @@
 #include <dpl/wrt-dao-ro/plugin_dao_read_only.h>
 
 #include <sstream>
+#include <set>
 #include <dpl/log/log.h>
 #include <dpl/foreach.h>
+#include <dpl/mutex.h>
+#include <dpl/scoped_ptr.h>
 #include <dpl/wrt-dao-ro/webruntime_database.h>
 #include <dpl/db/orm.h>
 #include <orm_generator_wrt.h>
@@ -58,6 +61,107 @@ PluginRow getPluginRow(DbPluginHandle pluginHandle)
                    "Failed in GetPluginRow");
     }
 }
+
+// Graph is shared by all threads and replaced when plugin tables change
+DPL::Mutex g_pluginGraphMutex;
+PluginGraphPtr g_pluginGraph;
+
+std::set<DPL::String> getPluginTableNames()
+{
+    std::set<DPL::String> names;
+    names.insert(L"PluginProperties");
+    names.insert(L"PluginDependencies");
+    names.insert(L"PluginImplementedObjects");
+    names.insert(L"PluginRequiredObjects");
+    return names;
+}
+}
+
+PluginGraph::PluginGraph(int version) :
+    m_version(version)
+{
+}
+
+int PluginGraph::getVersion() const
+{
+    return m_version;
+}
+
+DbPluginHandle PluginGraph::getPluginHandleForImplementedObject(
+        const std::string& objectName) const
+{
+    ObjectHandleMap::const_iterator it = m_objectHandles.find(objectName);
+
+    if (it == m_objectHandles.end()) {
+        LogWarning("PluginHandle for object not found");
+        return INVALID_PLUGIN_HANDLE;
+    }
+    return it->second;
+}
+
+ImplementedObjectsList PluginGraph::getImplementedObjects(
+        DbPluginHandle handle) const
+{
+    ObjectListMap::const_iterator it = m_implementedObjects.find(handle);
+
+    if (it == m_implementedObjects.end()) {
+        LogWarning("PluginHandle for object not found");
+        return ImplementedObjectsList();
+    }
+    return it->second;
+}
+
+PluginObjectsDAO::ObjectsPtr PluginGraph::getRequiredObjects(
+        DbPluginHandle handle) const
+{
+    ObjectSetMap::const_iterator it = m_requiredObjects.find(handle);
+
+    if (it == m_requiredObjects.end()) {
+        return PluginObjectsDAO::ObjectsPtr(new PluginObjectsDAO::Objects);
+    }
+    return PluginObjectsDAO::ObjectsPtr(
+               new PluginObjectsDAO::Objects(it->second));
+}
+
+PluginHandleSetPtr PluginGraph::getLibraryDependencies(
+        DbPluginHandle handle) const
+{
+    DependencyMap::const_iterator it = m_dependencies.find(handle);
+
+    if (it == m_dependencies.end()) {
+        return PluginHandleSetPtr(new PluginHandleSet);
+    }
+    return PluginHandleSetPtr(new PluginHandleSet(it->second));
+}
+
+const PluginHandleList& PluginGraph::getLoadOrder(DbPluginHandle handle) const
+{
+    LoadOrderMap::const_iterator it = m_loadOrders.find(handle);
+
+    if (it == m_loadOrders.end()) {
+        return m_emptyLoadOrder;
+    }
+    return it->second;
+}
+
+void PluginGraph::buildLoadOrder(DbPluginHandle handle,
+                                 PluginHandleSet& visited,
+                                 PluginHandleList& order) const
+{
+    // Visited plugins are skipped, which also breaks dependency cycles
+    if (!visited.insert(handle).second) {
+        return;
+    }
+
+    DependencyMap::const_iterator it = m_dependencies.find(handle);
+
+    if (it != m_dependencies.end()) {
+        FOREACH(dependency, it->second)
+        {
+            buildLoadOrder(*dependency, visited, order);
+        }
+    }
+    order.push_back(handle);
 }
 
 PluginDAOReadOnly::PluginDAOReadOnly(DbPluginHandle pluginHandle) :
@@ -117,9 +221,7 @@ bool PluginDAOReadOnly::isPluginInstalled(const std::string &libraryName)
         select->Where(Equals<PluginProperties::PluginLibraryName>(
                           DPL::FromUTF8String(libraryName)));
 
-        PluginProperties::Select::RowList rows = select->GetRowList();
-
-        bool flag = !rows.empty();
+        bool flag = select->Exists();
         LogDebug(" >> Plugin " << libraryName <<
                  (flag ? " found." : " not found."));
 
@@ -189,31 +291,7 @@ std::string PluginDAOReadOnly::getLibraryName() const
 
 PluginHandleSetPtr PluginDAOReadOnly::getLibraryDependencies() const
 {
-    Try
-    {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        PluginHandleSetPtr dependencies(new PluginHandleSet);
-
-        WRT_DB_SELECT(select, PluginDependencies, &WrtDatabase::interface())
-        select->Where(
-            Equals<PluginDependencies::PluginPropertiesId>(m_pluginHandle));
-
-        PluginDependencies::Select::RowList rows = select->GetRowList();
-
-        if (!rows.empty()) {
-            FOREACH(it, rows)
-            {
-                dependencies->insert(it->Get_RequiredPluginPropertiesId());
-            }
-        }
-
-        return dependencies;
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base) {
-        ReThrowMsg(PluginDAOReadOnly::Exception::DatabaseError,
-                   "Failed in GetLibraryDependencies");
-    }
+    return getPluginGraph()->getLibraryDependencies(m_pluginHandle);
 }
 
 DbPluginHandle PluginDAOReadOnly::getPluginHandleForImplementedObject(
@@ -221,31 +299,7 @@ DbPluginHandle PluginDAOReadOnly::getPluginHandleForImplementedObject(
 {
     LogDebug("GetPluginHandle for object: " << objectName);
 
-    Try
-    {
-        DbPluginHandle pluginHandle = INVALID_PLUGIN_HANDLE;
-
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-
-        WRT_DB_SELECT(select, PluginImplementedObjects, &WrtDatabase::interface())
-        select->Where(
-            Equals<PluginImplementedObjects::PluginObject>(
-                DPL::FromUTF8String(objectName)));
-
-        PluginImplementedObjects::Select::RowList rows = select->GetRowList();
-
-        if (!rows.empty()) {
-            pluginHandle = rows.front().Get_PluginPropertiesId();
-        } else {
-            LogWarning("PluginHandle for object not found");
-        }
-        return pluginHandle;
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base) {
-        ReThrowMsg(PluginDAOReadOnly::Exception::DatabaseError,
-                   "Failed in GetPluginHandleForImplementedObject");
-    }
+    return getPluginGraph()->getPluginHandleForImplementedObject(objectName);
 }
 
 ImplementedObjectsList PluginDAOReadOnly::getImplementedObjectsForPluginHandle(
@@ -253,63 +307,119 @@ ImplementedObjectsList PluginDAOReadOnly::getImplementedObjectsForPluginHandle(
 {
     LogDebug("getImplementedObjects for pluginHandle: " << handle);
 
+    return getPluginGraph()->getImplementedObjects(handle);
+}
+
+PluginObjectsDAO::ObjectsPtr PluginDAOReadOnly::getRequiredObjectsForPluginHandle(
+        DbPluginHandle handle)
+{
+    return getPluginGraph()->getRequiredObjects(handle);
+}
+
+PluginGraphPtr PluginDAOReadOnly::getPluginGraph()
+{
     Try
     {
-        ImplementedObjectsList objectList;
+        std::set<DPL::String> tableNames = getPluginTableNames();
+        int version = WrtDatabase::GetTablesVersion(tableNames);
+
+        {
+            DPL::Mutex::ScopedLock graphLock(&g_pluginGraphMutex);
+
+            if (!!g_pluginGraph && g_pluginGraph->getVersion() == version) {
+                return g_pluginGraph;
+            }
+        }
+
+        // Graph is built without mutex, so that readers of current graph
+        // are not blocked by database access
+
         using namespace DPL::DB::ORM;
         using namespace DPL::DB::ORM::wrt;
 
-        WRT_DB_SELECT(select, PluginImplementedObjects, &WrtDatabase::interface())
-        select->Where(
-            Equals<PluginImplementedObjects::PluginPropertiesId>(handle));
+        // Caller's transaction may hold uncommitted plugin data, which
+        // cannot be shared with other threads
+        bool shared = !WrtDatabase::interface().IsInTransaction();
 
-        PluginImplementedObjects::Select::RowList rows = select->GetRowList();
+        // Version is read again in transaction, so that it matches data
+        ScopedTransaction transaction(&WrtDatabase::interface());
+        version = WrtDatabase::GetTablesVersion(tableNames);
+
+        LogDebug("Building plugin graph. Version: " << version);
+
+        DPL::ScopedPtr<PluginGraph> graph(new PluginGraph(version));
+
+        {
+            WRT_DB_SELECT(select, PluginImplementedObjects,
+                          &WrtDatabase::interface())
+            PluginImplementedObjects::Select::RowList rows =
+                select->GetRowList();
 
-        if (!rows.empty()) {
             FOREACH(it, rows)
             {
-                objectList.push_back(DPL::ToUTF8String(it->Get_PluginObject()));
+                std::string object = DPL::ToUTF8String(it->Get_PluginObject());
+                graph->m_objectHandles[object] = it->Get_PluginPropertiesId();
+                graph->m_implementedObjects[it->Get_PluginPropertiesId()].
+                    push_back(object);
             }
-        } else {
-            LogWarning("PluginHandle for object not found");
         }
-        return objectList;
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base) {
-        ReThrowMsg(PluginDAOReadOnly::Exception::DatabaseError,
-                   "Failed in GetPluginHandleForImplementedObject");
-    }
-}
 
-PluginObjectsDAO::ObjectsPtr PluginDAOReadOnly::getRequiredObjectsForPluginHandle(
-        DbPluginHandle handle)
-{
-    Try
-    {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-
-        PluginObjectsDAO::ObjectsPtr objects =
-            PluginObjectsDAO::ObjectsPtr(new PluginObjectsDAO::Objects);
+        {
+            WRT_DB_SELECT(select, PluginRequiredObjects,
+                          &WrtDatabase::interface())
+            PluginRequiredObjects::Select::RowList rows = select->GetRowList();
 
-        WRT_DB_SELECT(select, PluginRequiredObjects, &WrtDatabase::interface())
-        select->Where(
-            Equals<PluginRequiredObjects::PluginPropertiesId>(handle));
+            FOREACH(it, rows)
+            {
+                graph->m_requiredObjects[it->Get_PluginPropertiesId()].insert(
+                    DPL::ToUTF8String(it->Get_PluginObject()));
+            }
+        }
 
-        PluginRequiredObjects::Select::RowList rows = select->GetRowList();
+        {
+            WRT_DB_SELECT(select, PluginDependencies,
+                          &WrtDatabase::interface())
+            PluginDependencies::Select::RowList rows = select->GetRowList();
 
-        if (!rows.empty()) {
             FOREACH(it, rows)
             {
-                objects->insert(DPL::ToUTF8String(it->Get_PluginObject()));
+                graph->m_dependencies[it->Get_PluginPropertiesId()].insert(
+                    it->Get_RequiredPluginPropertiesId());
             }
         }
 
-        return objects;
+        {
+            WRT_DB_SELECT(select, PluginProperties, &WrtDatabase::interface())
+            PluginHandleList handles =
+                select->GetValueList<PluginProperties::PluginPropertiesId>();
+
+            FOREACH(it, handles)
+            {
+                PluginHandleSet visited;
+                graph->buildLoadOrder(*it, visited, graph->m_loadOrders[*it]);
+            }
+        }
+
+        transaction.Commit();
+
+        PluginGraphPtr result(graph.Release());
+
+        if (!shared) {
+            return result;
+        }
+
+        DPL::Mutex::ScopedLock graphLock(&g_pluginGraphMutex);
+
+        // Other thread may have stored newer graph meanwhile
+        if (!g_pluginGraph || g_pluginGraph->getVersion() <= version) {
+            g_pluginGraph = result;
+        }
+
+        return result;
     }
     Catch(DPL::DB::SqlConnection::Exception::Base) {
         ReThrowMsg(PluginDAOReadOnly::Exception::DatabaseError,
-                   "Failed in GetRequiredObjectsForPluginHandle");
+                   "Failed in GetPluginGraph");
     }
 }
 
@@ -385,11 +495,7 @@ bool PluginDAOReadOnly::isPluginInstalled(DbPluginHandle pluginHandle)
         select->Where(
             Equals<PluginProperties::PluginPropertiesId>(pluginHandle));
 
-        PluginProperties::Select::RowList rows = select->GetRowList();
-
-        bool flag = !rows.empty();
-
-        return flag;
+        return select->Exists();
     }
     Catch(DPL::DB::SqlConnection::Exception::Base) {
         ReThrowMsg(PluginDAOReadOnly::Exception::DatabaseError,
@@ -0,0 +1,853 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file    property_cache.cpp
+ * @version 1.0
+ * @brief   This file contains the definition of widget preference cache
+ */
+
+#include "property_cache.h"
+
+#include <list>
+#include <map>
+#include <set>
+
+#include <dpl/db/deferred_writer.h>
+#include <dpl/foreach.h>
+#include <dpl/log/log.h>
+#include <dpl/monotonic_time.h>
+#include <dpl/mutex.h>
+#include <dpl/noncopyable.h>
+#include <dpl/scoped_ptr.h>
+#include <dpl/wrt-dao-ro/webruntime_database.h>
+#include <dpl/wrt-dao-ro/WrtDatabase.h>
+#include <orm_generator_wrt.h>
+
+namespace WrtDB {
+
+using PropertyDAOReadOnly::WidgetPropertyKey;
+using PropertyDAOReadOnly::WidgetPropertyValue;
+using PropertyDAOReadOnly::WidgetPropertyKeyList;
+using PropertyDAOReadOnly::WidgetPreferenceRow;
+using PropertyDAOReadOnly::WidgetPreferenceList;
+using PropertyDAOReadOnly::FlushStatistics;
+
+namespace {
+
+// Version of WidgetPreference is checked at most once per interval
+const uint64_t VERSION_CHECK_INTERVAL = 1000000; // [us]
+
+struct Entry
+{
+    WidgetPropertyValue value;
+    DPL::OptionalInt readonly;
+    bool stored;              // Row exists in database
+    bool removed;             // Property is removed, row may still exist
+    bool dirty;               // Change is not written yet
+    unsigned long generation; // Incremented on every change
+    uint64_t changeTime;      // Time of first unwritten change [us]
+
+    Entry() :
+        stored(false),
+        removed(false),
+        dirty(false),
+        generation(0),
+        changeTime(0)
+    {
+    }
+};
+
+typedef std::map<WidgetPropertyKey, Entry> EntryMap;
+
+struct WidgetEntries
+{
+    EntryMap entries;
+    // False when only dirty entries are kept and the rest must be
+    // loaded from database
+    bool complete;
+
+    WidgetEntries() :
+        complete(false)
+    {
+    }
+};
+
+typedef std::map<DbWidgetHandle, WidgetEntries> WidgetMap;
+
+struct PendingWrite
+{
+    DbWidgetHandle widgetHandle;
+    WidgetPropertyKey key;
+    Entry entry;
+};
+
+typedef std::list<PendingWrite> PendingWriteList;
+
+typedef std::list<DPL::DB::ORM::wrt::WidgetPreference::Row> RowList;
+
+DPL::Mutex g_cacheMutex;
+WidgetMap g_widgets;
+unsigned long g_generation = 0;
+// Incremented when cached rows may not match rows loaded before any more
+unsigned long g_epoch = 0;
+int g_version = 0;
+bool g_versionKnown = false;
+uint64_t g_versionCheckTime = 0;
+bool g_flushing = false;
+unsigned long g_flushDelay = 0; // [ms]
+FlushStatistics g_statistics = {};
+
+// Flushes are serialized, so older value never overwrites newer one
+DPL::Mutex g_flushMutex;
+
+void CheckWritable(const WidgetPropertyKey &key,
+                   const DPL::OptionalInt &readonly)
+{
+    if (!readonly.IsNull() && *readonly == 1) {
+        LogError("'" << key << "' key is readonly. Cannot change property !");
+        ThrowMsg(PropertyDAOReadOnly::Exception::ReadOnlyProperty,
+                 "Property is readonly");
+    }
+}
+
+const Entry *FindEntry(const WidgetEntries &widget,
+                       const WidgetPropertyKey &key)
+{
+    EntryMap::const_iterator it = widget.entries.find(key);
+
+    if (it == widget.entries.end() || it->second.removed) {
+        return NULL;
+    }
+    return &it->second;
+}
+
+RowList SelectRows(DbWidgetHandle widgetHandle)
+{
+    using namespace DPL::DB::ORM;
+    using namespace DPL::DB::ORM::wrt;
+
+    LogDebug("Loading properties. Handle: " << widgetHandle);
+
+    WRT_DB_SELECT(select, WidgetPreference, &WrtDatabase::interface())
+    select->Where(Equals<WidgetPreference::app_id>(widgetHandle));
+    return select->GetRowList();
+}
+
+// Adds rows missing in widget entries and fixes stored flag of dirty ones
+void MergeRows(const RowList &rows, WidgetEntries &widget)
+{
+    std::set<WidgetPropertyKey> storedKeys;
+
+    FOREACH(it, rows) {
+        storedKeys.insert(it->Get_key_name());
+
+        EntryMap::iterator entry = widget.entries.find(it->Get_key_name());
+
+        if (entry == widget.entries.end()) {
+            Entry &loaded = widget.entries[it->Get_key_name()];
+            loaded.value = it->Get_key_value();
+            loaded.readonly = it->Get_readonly();
+            loaded.stored = true;
+        }
+    }
+
+    FOREACH(it, widget.entries) {
+        if (it->second.dirty) {
+            it->second.stored = storedKeys.count(it->first) > 0;
+        }
+    }
+
+    widget.complete = true;
+}
+
+void DropCleanEntries()
+{
+    WidgetMap::iterator widget = g_widgets.begin();
+
+    while (widget != g_widgets.end()) {
+        EntryMap &entries = widget->second.entries;
+        EntryMap::iterator it = entries.begin();
+
+        while (it != entries.end()) {
+            if (it->second.dirty) {
+                ++it;
+            } else {
+                entries.erase(it++);
+            }
+        }
+
+        widget->second.complete = false;
+
+        if (entries.empty()) {
+            g_widgets.erase(widget++);
+        } else {
+            ++widget;
+        }
+    }
+
+    ++g_epoch;
+}
+
+bool IsVersionCheckDue()
+{
+    // Version is settled by flush in progress
+    return !g_flushing && (!g_versionKnown || DPL::GetMonotonicTime() -
+                           g_versionCheckTime >= VERSION_CHECK_INTERVAL);
+}
+
+// Drops cached rows when other process changed preferences
+void ApplyVersion(int version, uint64_t checkTime)
+{
+    // Flush or other thread settled version after it was read
+    if (g_flushing || (g_versionKnown && g_versionCheckTime > checkTime)) {
+        return;
+    }
+
+    if (!g_versionKnown || version != g_version) {
+        LogDebug("Properties changed. Version: " << version);
+        DropCleanEntries();
+    }
+
+    g_version = version;
+    g_versionKnown = true;
+    g_versionCheckTime = checkTime;
+}
+
+// Preferences visible to calling thread, cache mutex is held while view
+// exists. Inside caller's transaction they are read from its connection
+// and are not cached. Database is accessed with the mutex released, so
+// that readers of cached widgets are not blocked by it.
+class View :
+    private DPL::Noncopyable
+{
+  public:
+    explicit View(DbWidgetHandle widgetHandle) :
+        m_entries(NULL)
+    {
+        if (WrtDatabase::interface().IsInTransaction()) {
+            RowList rows = SelectRows(widgetHandle);
+            Lock();
+
+            WidgetMap::const_iterator widget = g_widgets.find(widgetHandle);
+
+            if (widget != g_widgets.end()) {
+                FOREACH(it, widget->second.entries) {
+                    if (it->second.dirty) {
+                        m_direct.entries.insert(*it);
+                    }
+                }
+            }
+
+            MergeRows(rows, m_direct);
+            m_entries = &m_direct;
+            return;
+        }
+
+        Lock();
+
+        for (;;) {
+            if (IsVersionCheckDue()) {
+                Unlock();
+                uint64_t checkTime = DPL::GetMonotonicTime();
+                int version = WrtDatabase::GetTableVersion("WidgetPreference");
+                Lock();
+                ApplyVersion(version, checkTime);
+            }
+
+            WidgetEntries &widget = g_widgets[widgetHandle];
+
+            if (widget.complete) {
+                m_entries = &widget;
+                return;
+            }
+
+            unsigned long epoch = g_epoch;
+
+            Unlock();
+            RowList rows = SelectRows(widgetHandle);
+            Lock();
+
+            // Otherwise rows may be stale, they are loaded again
+            if (epoch == g_epoch) {
+                WidgetEntries &loaded = g_widgets[widgetHandle];
+                MergeRows(rows, loaded);
+                m_entries = &loaded;
+                return;
+            }
+        }
+    }
+
+    const WidgetEntries &GetEntries() const
+    {
+        return *m_entries;
+    }
+
+    // Changes are written directly inside caller's transaction
+    bool IsDirect() const
+    {
+        return m_entries == &m_direct;
+    }
+
+  private:
+    DPL::ScopedPtr<DPL::Mutex::ScopedLock> m_lock;
+    WidgetEntries m_direct;
+    const WidgetEntries *m_entries;
+
+    void Lock()
+    {
+        m_lock.Reset(new DPL::Mutex::ScopedLock(&g_cacheMutex));
+    }
+
+    void Unlock()
+    {
+        m_lock.Reset();
+    }
+};
+
+// Prepared for each flush, which runs on connection of calling thread
+struct RowWriter
+{
+    DPL::DB::ORM::wrt::WidgetPreference::Select select;
+    DPL::DB::ORM::wrt::WidgetPreference::Insert insert;
+    DPL::DB::ORM::wrt::WidgetPreference::Update update;
+    DPL::DB::ORM::wrt::WidgetPreference::Delete del;
+    DPL::DB::ORM::wrt::TableVersions::Select version;
+
+    RowWriter() :
+        select(&WrtDatabase::interface()),
+        insert(&WrtDatabase::interface()),
+        update(&WrtDatabase::interface()),
+        del(&WrtDatabase::interface()),
+        version(&WrtDatabase::interface())
+    {
+    }
+};
+
+int ReadVersion(RowWriter &writer)
+{
+    using namespace DPL::DB::ORM;
+    using namespace DPL::DB::ORM::wrt;
+
+    writer.version.Where(Equals<TableVersions::name>(
+                             DPL::FromASCIIString("WidgetPreference")));
+
+    std::list<TableVersions::version::ColumnType> versions =
+        writer.version.GetValueList<TableVersions::version>();
+
+    return versions.empty() ? 0 : versions.front();
+}
+
+bool RowExists(RowWriter &writer,
+               DbWidgetHandle widgetHandle,
+               const WidgetPropertyKey &key)
+{
+    using namespace DPL::DB::ORM;
+    using namespace DPL::DB::ORM::wrt;
+
+    writer.select.Where(And(Equals<WidgetPreference::app_id>(widgetHandle),
+                            Equals<WidgetPreference::key_name>(key)));
+    return writer.select.Exists();
+}
+
+void WriteRow(RowWriter &writer,
+              DbWidgetHandle widgetHandle,
+              const WidgetPropertyKey &key,
+              const Entry &entry)
+{
+    using namespace DPL::DB::ORM;
+    using namespace DPL::DB::ORM::wrt;
+
+    if (entry.removed) {
+        if (entry.stored) {
+            writer.del.Where(And(
+                                 Equals<WidgetPreference::app_id>(widgetHandle),
+                                 Equals<WidgetPreference::key_name>(key)));
+            writer.del.Execute();
+        }
+    } else if (entry.stored) {
+        WidgetPreference::Row row;
+        row.Set_key_value(entry.value);
+        row.Set_readonly(entry.readonly);
+
+        writer.update.Where(And(
+                                Equals<WidgetPreference::app_id>(widgetHandle),
+                                Equals<WidgetPreference::key_name>(key)));
+        writer.update.Values(row);
+        writer.update.Execute();
+    } else {
+        WidgetPreference::Row row;
+        row.Set_app_id(widgetHandle);
+        row.Set_key_name(key);
+        row.Set_key_value(entry.value);
+        row.Set_readonly(entry.readonly);
+
+        writer.insert.Values(row);
+        writer.insert.Execute();
+    }
+}
+
+// Writes change made inside caller's transaction. Cached entry is dropped,
+// as the transaction may still be rolled back.
+void WriteDirectly(DbWidgetHandle widgetHandle,
+                   const WidgetPropertyKey &key,
+                   const Entry &entry)
+{
+    RowWriter writer;
+    WriteRow(writer, widgetHandle, key, entry);
+
+    DPL::Mutex::ScopedLock lock(&g_cacheMutex);
+
+    WidgetMap::iterator widget = g_widgets.find(widgetHandle);
+
+    if (widget != g_widgets.end()) {
+        widget->second.entries.erase(key);
+        widget->second.complete = false;
+    }
+
+    ++g_epoch;
+}
+
+// Pending changes of failed flush are dropped, so that cache serves
+// database content again. Entries changed during flush stay dirty.
+void DropPendingEntries(const PendingWriteList &pending)
+{
+    FOREACH(it, pending) {
+        WidgetMap::iterator widget = g_widgets.find(it->widgetHandle);
+
+        if (widget == g_widgets.end()) {
+            continue;
+        }
+
+        EntryMap::iterator entry = widget->second.entries.find(it->key);
+
+        if (entry != widget->second.entries.end() &&
+            entry->second.generation == it->entry.generation)
+        {
+            widget->second.entries.erase(entry);
+            widget->second.complete = false;
+        }
+    }
+
+    ++g_epoch;
+}
+
+void MarkDirty(Entry &entry)
+{
+    ++g_statistics.writes;
+
+    if (entry.dirty) {
+        ++g_statistics.coalescedWrites;
+    } else {
+        entry.dirty = true;
+        entry.changeTime = DPL::GetMonotonicTime();
+    }
+    entry.generation = ++g_generation;
+}
+
+void Flush()
+{
+    DPL::Mutex::ScopedLock flushLock(&g_flushMutex);
+
+    PendingWriteList pending;
+    int version;
+    bool versionKnown;
+
+    {
+        DPL::Mutex::ScopedLock lock(&g_cacheMutex);
+
+        FOREACH(widget, g_widgets) {
+            FOREACH(it, widget->second.entries) {
+                if (it->second.dirty) {
+                    PendingWrite write;
+                    write.widgetHandle = widget->first;
+                    write.key = it->first;
+                    write.entry = it->second;
+                    pending.push_back(write);
+                }
+            }
+        }
+
+        if (pending.empty()) {
+            return;
+        }
+
+        g_flushing = true;
+        version = g_version;
+        versionKnown = g_versionKnown;
+    }
+
+    LogDebug("Flushing " << pending.size() << " properties");
+
+    uint64_t start = DPL::GetMonotonicTime();
+    bool externalChange = false;
+    int newVersion = 0;
+
+    Try {
+        DPL::DB::ORM::wrt::ScopedTransaction transaction(
+            &WrtDatabase::interface());
+
+        RowWriter writer;
+
+        externalChange = !versionKnown || ReadVersion(writer) != version;
+
+        FOREACH(it, pending) {
+            // Rows may have been added or removed by other process
+            if (externalChange) {
+                it->entry.stored =
+                    RowExists(writer, it->widgetHandle, it->key);
+            }
+            WriteRow(writer, it->widgetHandle, it->key, it->entry);
+        }
+
+        newVersion = ReadVersion(writer);
+        transaction.Commit();
+    }
+    Catch(DPL::DB::SqlConnection::Exception::Base){
+        {
+            DPL::Mutex::ScopedLock lock(&g_cacheMutex);
+            DropPendingEntries(pending);
+            g_flushing = false;
+            ++g_statistics.failedFlushes;
+        }
+
+        LogError("Failed to flush " << pending.size() << " properties");
+        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
+                   "Failure during flushing properties");
+    }
+
+    uint64_t end = DPL::GetMonotonicTime();
+
+    DPL::Mutex::ScopedLock lock(&g_cacheMutex);
+
+    g_flushing = false;
+
+    if (externalChange) {
+        DropCleanEntries();
+    }
+
+    g_version = newVersion;
+    g_versionKnown = true;
+    g_versionCheckTime = end;
+    ++g_epoch;
+
+    FOREACH(it, pending) {
+        if (end - it->entry.changeTime > g_statistics.maxWriteDelay) {
+            g_statistics.maxWriteDelay = end - it->entry.changeTime;
+        }
+
+        WidgetMap::iterator widget = g_widgets.find(it->widgetHandle);
+
+        if (widget == g_widgets.end()) {
+            continue;
+        }
+
+        EntryMap::iterator entry = widget->second.entries.find(it->key);
+
+        if (entry == widget->second.entries.end()) {
+            continue;
+        }
+
+        entry->second.stored = !it->entry.removed;
+
+        // Entry changed again during flush stays dirty
+        if (entry->second.generation == it->entry.generation) {
+            if (it->entry.removed) {
+                widget->second.entries.erase(entry);
+            } else {
+                entry->second.dirty = false;
+            }
+        }
+    }
+
+    ++g_statistics.flushes;
+    g_statistics.flushedRows += pending.size();
+    g_statistics.totalFlushTime += end - start;
+
+    if (end - start > g_statistics.maxFlushTime) {
+        g_statistics.maxFlushTime = end - start;
+    }
+}
+
+class PropertyWriter :
+    public DPL::DB::DeferredWriter
+{
+  public:
+    PropertyWriter() :
+        DPL::DB::DeferredWriter("properties")
+    {
+    }
+
+  protected:
+    virtual void AttachToThread()
+    {
+        WrtDatabase::attachToThreadRW();
+    }
+
+    virtual void DetachFromThread()
+    {
+        WrtDatabase::detachFromThread();
+    }
+
+    virtual void Write()
+    {
+        Flush();
+    }
+};
+
+PropertyWriter g_writer;
+
+void ScheduleFlush()
+{
+    g_writer.Schedule(static_cast<double>(g_flushDelay) / 1000);
+}
+} // namespace
+
+WidgetPreferenceList PropertyCache::GetPropertyList(
+        DbWidgetHandle widgetHandle)
+{
+    Try {
+        View view(widgetHandle);
+        const WidgetEntries &widget = view.GetEntries();
+
+        WidgetPreferenceList list;
+
+        FOREACH(it, widget.entries) {
+            if (!it->second.removed) {
+                WidgetPreferenceRow row;
+                row.app_id = widgetHandle;
+                row.key_name = it->first;
+                row.key_value = it->second.value;
+                row.readonly = it->second.readonly;
+                list.push_back(row);
+            }
+        }
+        return list;
+    }
+    Catch(DPL::DB::SqlConnection::Exception::Base){
+        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
+                   "Failure during getting property list");
+    }
+}
+
+WidgetPropertyKeyList PropertyCache::GetPropertyKeyList(
+        DbWidgetHandle widgetHandle)
+{
+    Try {
+        View view(widgetHandle);
+        const WidgetEntries &widget = view.GetEntries();
+
+        WidgetPropertyKeyList list;
+
+        FOREACH(it, widget.entries) {
+            if (!it->second.removed) {
+                list.push_back(it->first);
+            }
+        }
+        return list;
+    }
+    Catch(DPL::DB::SqlConnection::Exception::Base){
+        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
+                   "Failure during getting propertykey list");
+    }
+}
+
+WidgetPropertyValue PropertyCache::GetPropertyValue(
+        DbWidgetHandle widgetHandle,
+        const WidgetPropertyKey &key)
+{
+    Try {
+        View view(widgetHandle);
+        const Entry *entry = FindEntry(view.GetEntries(), key);
+
+        return entry ? entry->value : WidgetPropertyValue();
+    }
+    Catch(DPL::DB::SqlConnection::Exception::Base){
+        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
+                   "Failure during getting property");
+    }
+}
+
+DPL::OptionalInt PropertyCache::GetReadFlag(
+        DbWidgetHandle widgetHandle,
+        const WidgetPropertyKey &key)
+{
+    Try {
+        View view(widgetHandle);
+        const Entry *entry = FindEntry(view.GetEntries(), key);
+
+        return entry ? entry->readonly : DPL::OptionalInt();
+    }
+    Catch(DPL::DB::SqlConnection::Exception::Base){
+        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
+                   "Failure during checking readonly flag for property");
+    }
+}
+
+void PropertyCache::SetProperty(
+        DbWidgetHandle widgetHandle,
+        const WidgetPropertyKey &key,
+        const WidgetPropertyValue &value,
+        bool readOnly)
+{
+    Try {
+        bool flushNow = false;
+        bool direct = false;
+        Entry change;
+
+        {
+            View view(widgetHandle);
+            const WidgetEntries &current = view.GetEntries();
+            const Entry *existing = FindEntry(current, key);
+
+            if (existing) {
+                CheckWritable(key, existing->readonly);
+            }
+
+            EntryMap::const_iterator it = current.entries.find(key);
+
+            if (it != current.entries.end()) {
+                change = it->second;
+            }
+
+            // Readonly flag is set only for new property
+            if (!existing) {
+                change.readonly = readOnly ? 1 : 0;
+            }
+            change.value = value;
+            change.removed = false;
+
+            if (view.IsDirect()) {
+                direct = true;
+            } else {
+                Entry &entry = g_widgets[widgetHandle].entries[key];
+                entry.value = change.value;
+                entry.readonly = change.readonly;
+                entry.removed = false;
+                MarkDirty(entry);
+
+                flushNow = g_flushDelay == 0;
+
+                if (!flushNow) {
+                    ScheduleFlush();
+                }
+            }
+        }
+
+        if (direct) {
+            WriteDirectly(widgetHandle, key, change);
+        }
+
+        if (flushNow) {
+            Flush();
+        }
+    }
+    Catch(DPL::DB::SqlConnection::Exception::Base){
+        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
+                   "Failure during setting/updating property");
+    }
+}
+
+void PropertyCache::RemoveProperty(
+        DbWidgetHandle widgetHandle,
+        const WidgetPropertyKey &key)
+{
+    Try {
+        bool flushNow = false;
+        bool direct = false;
+        Entry change;
+
+        {
+            View view(widgetHandle);
+            const Entry *existing = FindEntry(view.GetEntries(), key);
+
+            if (!existing) {
+                return;
+            }
+
+            CheckWritable(key, existing->readonly);
+
+            if (view.IsDirect()) {
+                change = *existing;
+                change.removed = true;
+                direct = true;
+            } else {
+                Entry &entry = g_widgets[widgetHandle].entries[key];
+                entry.value = WidgetPropertyValue();
+                entry.removed = true;
+                MarkDirty(entry);
+
+                flushNow = g_flushDelay == 0;
+
+                if (!flushNow) {
+                    ScheduleFlush();
+                }
+            }
+        }
+
+        if (direct) {
+            WriteDirectly(widgetHandle, key, change);
+        }
+
+        if (flushNow) {
+            Flush();
+        }
+    }
+    Catch(DPL::DB::SqlConnection::Exception::Base){
+        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
+                   "Failure during removing property");
+    }
+}
+
+void PropertyCache::Invalidate(DbWidgetHandle widgetHandle)
+{
+    DPL::Mutex::ScopedLock flushLock(&g_flushMutex);
+    DPL::Mutex::ScopedLock lock(&g_cacheMutex);
+
+    g_widgets.erase(widgetHandle);
+    ++g_epoch;
+}
+
+void PropertyCache::SetFlushDelay(unsigned long delay)
+{
+    {
+        DPL::Mutex::ScopedLock lock(&g_cacheMutex);
+        g_flushDelay = delay;
+    }
+
+    if (delay == 0) {
+        Sync();
+    }
+}
+
+void PropertyCache::Sync()
+{
+    // Flush would join caller's transaction and mark changes written
+    // before it commits. Changes are left to flush already scheduled.
+    if (WrtDatabase::interface().IsInTransaction()) {
+        LogDebug("Sync inside transaction is deferred");
+        return;
+    }
+
+    Flush();
+}
+
+FlushStatistics PropertyCache::GetStatistics()
+{
+    DPL::Mutex::ScopedLock lock(&g_cacheMutex);
+    return g_statistics;
+}
+
+} // namespace WrtDB
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file    property_cache.h
+ * @version 1.0
+ * @brief   This file contains the declaration of widget preference cache
+ */
+
+#ifndef WRT_SRC_CONFIGURATION_PROPERTY_CACHE_H_
+#define WRT_SRC_CONFIGURATION_PROPERTY_CACHE_H_
+
+#include <dpl/wrt-dao-ro/property_dao_read_only.h>
+
+namespace WrtDB {
+
+/**
+ * Write-back cache of WidgetPreference table
+ *
+ * Preferences of a widget are loaded with one query on first access and
+ * served from memory afterwards. Changes are applied to memory and marked
+ * dirty. Dirty entries of all widgets are written in single transaction
+ * after flush delay, on Sync() and at process exit. With flush delay 0
+ * every change is written before the setter returns.
+ *
+ * Changes made by other processes are noticed via WidgetPreference
+ * counter in TableVersions, checked at most once per interval.
+ * Calls made inside caller's transaction go to database directly.
+ */
+class PropertyCache
+{
+  public:
+    static PropertyDAOReadOnly::WidgetPreferenceList GetPropertyList(
+            DbWidgetHandle widgetHandle);
+
+    static PropertyDAOReadOnly::WidgetPropertyKeyList GetPropertyKeyList(
+            DbWidgetHandle widgetHandle);
+
+    static PropertyDAOReadOnly::WidgetPropertyValue GetPropertyValue(
+            DbWidgetHandle widgetHandle,
+            const PropertyDAOReadOnly::WidgetPropertyKey &key);
+
+    static DPL::OptionalInt GetReadFlag(
+            DbWidgetHandle widgetHandle,
+            const PropertyDAOReadOnly::WidgetPropertyKey &key);
+
+    /**
+     * Throws PropertyDAOReadOnly::Exception::ReadOnlyProperty when
+     * property is readonly. Readonly flag is used only for new property.
+     */
+    static void SetProperty(
+            DbWidgetHandle widgetHandle,
+            const PropertyDAOReadOnly::WidgetPropertyKey &key,
+            const PropertyDAOReadOnly::WidgetPropertyValue &value,
+            bool readOnly);
+
+    /**
+     * Throws PropertyDAOReadOnly::Exception::ReadOnlyProperty when
+     * property is readonly.
+     */
+    static void RemoveProperty(
+            DbWidgetHandle widgetHandle,
+            const PropertyDAOReadOnly::WidgetPropertyKey &key);
+
+    /**
+     * Drops cached preferences of widget, including unwritten changes.
+     * Waits for flush in progress. Called when widget is (un)registered.
+     */
+    static void Invalidate(DbWidgetHandle widgetHandle);
+
+    /**
+     * @param delay Time between first unwritten change and flush [ms]
+     */
+    static void SetFlushDelay(unsigned long delay);
+
+    /**
+     * Writes all unwritten changes in calling thread. Inside caller's
+     * transaction nothing is written, changes are left to scheduled flush.
+     */
+    static void Sync();
+
+    static PropertyDAOReadOnly::FlushStatistics GetStatistics();
+};
+
+} // namespace WrtDB
+
+#endif /* WRT_SRC_CONFIGURATION_PROPERTY_CACHE_H_ */
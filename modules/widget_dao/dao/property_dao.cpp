@@ -27,6 +27,7 @@
 #include <dpl/wrt-dao-ro/webruntime_database.h>
 #include <dpl/wrt-dao-ro/WrtDatabase.h>
 #include <orm_generator_wrt.h>
+#include "property_cache.h"
 
 namespace WrtDB {
 namespace PropertyDAO {
@@ -34,40 +35,8 @@ namespace PropertyDAO {
 void RemoveProperty(DbWidgetHandle widgetHandle,
                     const PropertyDAOReadOnly::WidgetPropertyKey &key)
 {
-    //TODO below there are two queries.
-    // First query asks if given property can be removed,
-    // Second removes it. Maybe it should be combined two one.
-
     LogDebug("Removing Property. Handle: " << widgetHandle << ", key: " << key);
-    Try {
-        DPL::DB::ORM::wrt::ScopedTransaction transaction(&WrtDatabase::interface());
-
-        DPL::OptionalInt readonly = PropertyDAOReadOnly::CheckPropertyReadFlag(
-                widgetHandle,
-                key);
-        if (!readonly.IsNull() && *readonly == 1) {
-            LogError("'" << key <<
-                     "' key is readonly. Cannot remove property !");
-            ThrowMsg(PropertyDAOReadOnly::Exception::ReadOnlyProperty,
-                     "Property is readonly");
-        }
-
-        // Key is not readonly, or has no flag defined
-
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        WRT_DB_DELETE(del, WidgetPreference, &WrtDatabase::interface())
-        del->Where(And(
-                       Equals<WidgetPreference::app_id>(widgetHandle),
-                       Equals<WidgetPreference::key_name>(key)));
-        del->Execute();
-
-        transaction.Commit();
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
-                   "Failure during removing property");
-    }
+    PropertyCache::RemoveProperty(widgetHandle, key);
 }
 
 void SetProperty(DbWidgetHandle widgetHandle,
@@ -77,49 +46,23 @@ void SetProperty(DbWidgetHandle widgetHandle,
 {
     LogDebug("Setting/updating Property. Handle: " << widgetHandle <<
              ", key: " << key);
-    Try {
-        using namespace DPL::DB::ORM;
-        using namespace DPL::DB::ORM::wrt;
-        DPL::DB::ORM::wrt::ScopedTransaction transaction(&WrtDatabase::interface());
-
-        DPL::OptionalInt readonly = PropertyDAOReadOnly::CheckPropertyReadFlag(
-                widgetHandle,
-                key);
-        if (!readonly.IsNull() && *readonly == 1) {
-            LogError("'" << key <<
-                     "' key is readonly. Cannot remove property !");
-            ThrowMsg(PropertyDAOReadOnly::Exception::ReadOnlyProperty,
-                     "Property is readonly");
-        }
-
-        if (readonly.IsNull()) {
-            WidgetPreference::Row row;
-            row.Set_app_id(widgetHandle);
-            row.Set_key_name(key);
-            row.Set_key_value(value);
-            row.Set_readonly(readOnly ? 1 : 0);
+    PropertyCache::SetProperty(widgetHandle, key, value, readOnly);
+}
 
-            WRT_DB_INSERT(insert, WidgetPreference, &WrtDatabase::interface())
-            insert->Values(row);
-            insert->Execute();
-        } else {
-            WidgetPreference::Row row;
-            row.Set_key_value(value);
+void SetFlushDelay(unsigned long delay)
+{
+    LogDebug("Setting property flush delay: " << delay << "ms");
+    PropertyCache::SetFlushDelay(delay);
+}
 
-            WRT_DB_UPDATE(update, WidgetPreference, &WrtDatabase::interface())
-            update->Where(And(
-                              Equals<WidgetPreference::app_id>(widgetHandle),
-                              Equals<WidgetPreference::key_name>(key)));
+void Sync()
+{
+    PropertyCache::Sync();
+}
 
-            update->Values(row);
-            update->Execute();
-        }
-        transaction.Commit();
-    }
-    Catch(DPL::DB::SqlConnection::Exception::Base){
-        ReThrowMsg(PropertyDAOReadOnly::Exception::DatabaseError,
-                   "Failure during setting/updating property");
-    }
+PropertyDAOReadOnly::FlushStatistics GetFlushStatistics()
+{
+    return PropertyCache::GetStatistics();
 }
 
 void RegisterProperties(DbWidgetHandle widgetHandle,
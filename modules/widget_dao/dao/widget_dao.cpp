@@ -35,6 +35,7 @@
 #include <dpl/wrt-dao-rw/property_dao.h>
 #include <orm_generator_wrt.h>
 #include <dpl/wrt-dao-ro/WrtDatabase.h>
+#include "property_cache.h"
 
 namespace WrtDB {
 
@@ -169,6 +170,8 @@ void WidgetDAO::registerWidget(
         transaction.Commit();
     }
     SQL_CONNECTION_EXCEPTION_HANDLER_END("Failed to register widget")
+
+    PropertyCache::Invalidate(widgetHandle);
 }
 
 #define DO_INSERT(row, table)                              \
@@ -306,9 +309,7 @@ void WidgetDAO::registerWidgetIcons(DbWidgetHandle widgetHandle,
             WRT_DB_SELECT(select, WidgetLocalizedIcon, &WrtDatabase::interface())
             select->Where(And(Equals<WidgetLocalizedIcon::app_id>(widgetHandle),
                               Equals<WidgetLocalizedIcon::widget_locale>(*j)));
-            WidgetLocalizedIcon::Select::RowList rows = select->GetRowList();
-
-            bool flag = !rows.empty();
+            bool flag = select->Exists();
 
             if(flag == true)
             {
@@ -557,6 +558,10 @@ void WidgetDAO::registerEncryptedResouceInfo(DbWidgetHandle widgetHandle,
 void WidgetDAO::unregisterWidget(DbWidgetHandle widgetHandle)
 {
     LogDebug("Unregistering widget from DB. Handle: " << widgetHandle);
+
+    // Pending property changes must not be written after widget is gone
+    PropertyCache::Invalidate(widgetHandle);
+
     SQL_CONNECTION_EXCEPTION_HANDLER_BEGIN
     {
         DPL::DB::ORM::wrt::ScopedTransaction transaction(&WrtDatabase::interface());
@@ -577,6 +582,8 @@ void WidgetDAO::unregisterWidget(DbWidgetHandle widgetHandle)
         transaction.Commit();
     }
     SQL_CONNECTION_EXCEPTION_HANDLER_END("Failed to unregister widget")
+
+    PropertyCache::Invalidate(widgetHandle);
 }
 
 #undef SQL_CONNECTION_EXCEPTION_HANDLER_BEGIN
@@ -27,6 +27,7 @@
 #include <dpl/wrt-dao-ro/widget_dao_read_only.h>
 
 #include <sstream>
+#include <map>
 #include <dpl/foreach.h>
 #include <dpl/sstream.h>
 #include <dpl/wrt-dao-ro/global_config.h>
@@ -87,6 +88,30 @@ WidgetInfoRow getWidgetInfoRow(int widgetHandle)
     SQL_CONNECTION_EXCEPTION_HANDLER_END("Failed in GetWidgetInfoRow")
 }
 
+typedef std::map<DPL::String, DPL::String> LocalizedNameMap;
+
+DPL::OptionalString getPreferredName(const LocalizedNameMap& names,
+                                     const LanguageTagList& languageTags,
+                                     const DPL::OptionalString& defaultLocale)
+{
+    FOREACH(tag, languageTags)
+    {
+        LocalizedNameMap::const_iterator name = names.find(*tag);
+        if (name != names.end()) {
+            return DPL::OptionalString(name->second);
+        }
+    }
+
+    if (!!defaultLocale) {
+        LocalizedNameMap::const_iterator name = names.find(*defaultLocale);
+        if (name != names.end()) {
+            return DPL::OptionalString(name->second);
+        }
+    }
+
+    return DPL::OptionalString::Null;
+}
+
 } // namespace
 
 
@@ -322,9 +347,9 @@ bool WidgetDAOReadOnly::hasFeature(const std::string& featureName) const
                           Equals<wrt::WidgetFeature::name>(
                               DPL::FromUTF8String(featureName))));
 
-        wrt::WidgetFeature::Select::RowList rows = select->GetRowList();
+        bool result = select->Exists();
         transaction.Commit();
-        return !rows.empty();
+        return result;
     }
     SQL_CONNECTION_EXCEPTION_HANDLER_END("Failed to check for feature")
 }
@@ -373,6 +398,89 @@ DbWidgetHandleList WidgetDAOReadOnly::getHandleList()
     SQL_CONNECTION_EXCEPTION_HANDLER_END("Failed to get handle list")
 }
 
+WidgetSummaryList WidgetDAOReadOnly::getWidgetSummaries(
+        const LanguageTagList& languageTags)
+{
+    LogDebug("Getting widget summaries");
+    SQL_CONNECTION_EXCEPTION_HANDLER_BEGIN
+    {
+        using namespace DPL::DB::ORM;
+        using namespace DPL::DB::ORM::wrt;
+
+        DECLARE_COLUMN_TYPE_LIST()
+        SELECTED_COLUMN(WidgetInfo, app_id)
+        SELECTED_COLUMN(WidgetInfo, widget_id)
+        SELECTED_COLUMN(WidgetInfo, pkgname)
+        SELECTED_COLUMN(WidgetInfo, widget_type)
+        SELECTED_COLUMN(WidgetInfo, widget_version)
+        SELECTED_COLUMN(WidgetInfo, defaultlocale)
+        SELECTED_COLUMN(LocalizedWidgetInfo, widget_locale)
+        SELECTED_COLUMN(LocalizedWidgetInfo, widget_name)
+        DECLARE_COLUMN_TYPE_LIST_END(SummaryColumnList)
+
+        typedef CustomRow<SummaryColumnList> SummaryRow;
+
+        // One row per widget locale, widget without localized info is
+        // returned once with NULL name
+        WRT_DB_SELECT(select, WidgetInfo, &WrtDatabase::interface())
+        select->LeftJoin<SummaryColumnList>(
+            Equal<WidgetInfo::app_id, LocalizedWidgetInfo::app_id>());
+        select->OrderBy("WidgetInfo.app_id");
+
+        std::list<SummaryRow> rowList =
+            select->GetCustomRowList<SummaryColumnList, SummaryRow>();
+
+        WidgetSummaryList result;
+        LocalizedNameMap names;
+        DPL::OptionalString defaultLocale;
+
+        FOREACH(rowIt, rowList)
+        {
+            DbWidgetHandle handle = rowIt->GetColumnData<WidgetInfo::app_id>();
+
+            if (result.empty() || result.back().handle != handle) {
+                if (!result.empty()) {
+                    result.back().name =
+                        getPreferredName(names, languageTags, defaultLocale);
+                    names.clear();
+                }
+
+                WidgetSummary summary;
+                summary.handle = handle;
+                summary.guid = rowIt->GetColumnData<WidgetInfo::widget_id>();
+                summary.pkgname = rowIt->GetColumnData<WidgetInfo::pkgname>();
+                summary.version =
+                    rowIt->GetColumnData<WidgetInfo::widget_version>();
+
+                DPL::OptionalInt type =
+                    rowIt->GetColumnData<WidgetInfo::widget_type>();
+                if (!!type) {
+                    summary.type = WidgetType(static_cast<AppType>(*type));
+                }
+
+                defaultLocale =
+                    rowIt->GetColumnData<WidgetInfo::defaultlocale>();
+                result.push_back(summary);
+            }
+
+            DPL::OptionalString name =
+                rowIt->GetColumnData<LocalizedWidgetInfo::widget_name>();
+            if (!!name) {
+                names[rowIt->GetColumnData<
+                          LocalizedWidgetInfo::widget_locale>()] = *name;
+            }
+        }
+
+        if (!result.empty()) {
+            result.back().name =
+                getPreferredName(names, languageTags, defaultLocale);
+        }
+
+        return result;
+    }
+    SQL_CONNECTION_EXCEPTION_HANDLER_END("Failed to get widget summaries")
+}
+
 bool WidgetDAOReadOnly::isWidgetInstalled(DbWidgetHandle handle)
 {
     LogDebug("Checking if widget exist. Handle: " << handle);
@@ -383,9 +491,7 @@ bool WidgetDAOReadOnly::isWidgetInstalled(DbWidgetHandle handle)
         WRT_DB_SELECT(select, WidgetInfo, &WrtDatabase::interface())
         select->Where(Equals<WidgetInfo::app_id>(handle));
 
-        WidgetInfo::Select::RowList rows = select->GetRowList();
-
-        return !rows.empty();
+        return select->Exists();
     }
     SQL_CONNECTION_EXCEPTION_HANDLER_END("Failed to check if widget exist")
 }
@@ -400,9 +506,7 @@ bool WidgetDAOReadOnly::isWidgetInstalled(DPL::String pkgName)
         WRT_DB_SELECT(select, WidgetInfo, &WrtDatabase::interface())
         select->Where(Equals<WidgetInfo::pkgname>(pkgName));
 
-        WidgetInfo::Select::RowList rows = select->GetRowList();
-
-        return !rows.empty();
+        return select->Exists();
     }
     SQL_CONNECTION_EXCEPTION_HANDLER_END("Failed to check if widget exist")
 }
@@ -16,6 +16,8 @@
 #ifndef WRT_SRC_CONFIGURATION_WRTDATABASE_H_
 #define	WRT_SRC_CONFIGURATION_WRTDATABASE_H_
 
+#include <set>
+#include <dpl/string.h>
 #include <dpl/db/thread_database_support.h>
 
 namespace WrtDB {
@@ -31,6 +33,23 @@ class WrtDatabase
     static DPL::DB::ThreadDatabaseSupport& interface();
     static bool CheckTableExist(const char *name);
 
+    /**
+     * Version of whole database, changed by commits of other connections
+     */
+    static DPL::DB::SqlConnection::DataVersion GetDataVersion();
+
+    /**
+     * Version of table tracked in TableVersions, bumped on every write.
+     * Returns 0 for tables which are not tracked.
+     */
+    static int GetTableVersion(const char *name);
+
+    /**
+     * Combined version of tables tracked in TableVersions, read with single
+     * query. It changes whenever any of the tables is written.
+     */
+    static int GetTablesVersion(const std::set<DPL::String> &names);
+
   private:
     static DPL::DB::ThreadDatabaseSupport m_interface;
 };
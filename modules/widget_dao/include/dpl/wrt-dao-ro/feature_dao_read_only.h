@@ -24,8 +24,12 @@
 #define WRT_SRC_CONFIGURATION_FEATURE_DAO_READ_ONLY_H_
 
 #include <set>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <dpl/exception.h>
+#include <dpl/shared_ptr.h>
 #include <dpl/wrt-dao-ro/common_dao_types.h>
 #include "feature_model.h"
 #include <dpl/wrt-dao-ro/common_dao_types.h>
@@ -33,6 +37,9 @@
 
 namespace WrtDB {
 
+class FeatureCatalog;
+typedef DPL::SharedPtr<const FeatureCatalog> FeatureCatalogPtr;
+
 class FeatureDAOReadOnly
 {
   public:
@@ -73,10 +80,65 @@ class FeatureDAOReadOnly
     static NameMap                 GetNames();
     static DeviceCapabilitiesMap   GetDevCapWithFeatureHandle();
 
+    /**
+     * Get catalog of installed features and device capabilities. Catalog is
+     * cached in process and shared, validity of cached catalog is checked
+     * with single query.
+     */
+    static FeatureCatalogPtr       GetFeatureCatalog();
+
   protected:
     FeatureHandle m_featureHandle;
 };
 
+/**
+ * Immutable snapshot of installed features and their device capabilities.
+ *
+ * Catalog is loaded from database at once and shared by all its users, so
+ * security checks do not touch database. It is reloaded when any of
+ * feature or device capability tables changes.
+ */
+class FeatureCatalog
+{
+  public:
+    /**
+     * Version of feature tables the catalog was loaded from
+     */
+    int getVersion() const;
+
+    const FeatureDAOReadOnly::NameMap& getNames() const;
+    const FeatureDAOReadOnly::DeviceCapabilitiesMap&
+        getDevCapWithFeatureHandle() const;
+
+    /**
+     * Lookups below use hash indexes built when catalog is loaded
+     */
+    const FeatureDAOReadOnly::DeviceCapabilitiesList& getDeviceCapabilities(
+            FeatureHandle handle) const;
+    bool isFeatureInstalled(const std::string &featureName) const;
+    bool isFeatureInstalled(FeatureHandle handle) const;
+    bool isDeviceCapabilityInstalled(const std::string &deviceCapName) const;
+
+  private:
+    typedef std::unordered_map<std::string, FeatureHandle> HandleIndex;
+    typedef std::unordered_map<FeatureHandle,
+                               FeatureDAOReadOnly::DeviceCapabilitiesList>
+        DeviceCapabilitiesIndex;
+    typedef std::unordered_set<std::string> DeviceCapabilitySet;
+
+    explicit FeatureCatalog(int version);
+
+    int m_version;
+    FeatureDAOReadOnly::NameMap m_names;
+    FeatureDAOReadOnly::DeviceCapabilitiesMap m_devCaps;
+
+    HandleIndex m_handles;
+    DeviceCapabilitiesIndex m_featureDevCaps;
+    DeviceCapabilitySet m_installedDevCaps;
+
+    friend class FeatureDAOReadOnly;
+};
+
 } // namespace WrtDB
 
 #endif /* WRT_SRC_CONFIGURATION_FEATURE_DAO_READ_ONLY_H_ */
@@ -93,6 +93,29 @@ class GlobalDAOReadOnly
      */
     static NetworkAccessMode GetRoamingDataUsage();
 
+    /**
+     * Block of global settings stored in GlobalProperties
+     */
+    struct Settings
+    {
+        bool developerMode;
+        bool secureByDefault;
+        bool complianceMode;
+        std::string complianceFakeImei;
+        std::string complianceFakeMeid;
+        NetworkAccessMode homeNetworkDataUsage;
+        NetworkAccessMode roamingDataUsage;
+        bool cookieSharingMode;
+    };
+
+    /**
+     * This method returns all global settings. Settings are cached in
+     * process and read from database only when they have been changed.
+     *
+     * @return Global settings.
+     */
+    static Settings GetSettings();
+
     static DPL::String GetUserAgentValue(const DPL::String &key);
 
     /**
@@ -105,6 +128,12 @@ class GlobalDAOReadOnly
     GlobalDAOReadOnly()
     {
     }
+
+    /**
+     * Drop cached settings, so that next read gets them from database.
+     * Called by setters after GlobalProperties is updated.
+     */
+    static void RefreshSettings();
 };
 
 } // namespace WrtDB
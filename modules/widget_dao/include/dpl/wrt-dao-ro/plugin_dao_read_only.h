@@ -26,6 +26,7 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <dpl/exception.h>
 #include <dpl/shared_ptr.h>
 #include <dpl/wrt-dao-ro/common_dao_types.h>
@@ -37,6 +38,64 @@ typedef std::set<DbPluginHandle> PluginHandleSet;
 typedef std::list<std::string> ImplementedObjectsList;
 typedef DPL::SharedPtr<PluginHandleSet> PluginHandleSetPtr;
 
+/**
+ * Immutable snapshot of installed plugins' objects and dependencies.
+ *
+ * Graph is built from database at once and shared by all its users, so
+ * resolving plugins for widget does not touch database. It is rebuilt when
+ * any of plugin tables changes.
+ */
+class PluginGraph
+{
+  public:
+    /**
+     * Version of plugin tables the graph was built from
+     */
+    int getVersion() const;
+
+    DbPluginHandle getPluginHandleForImplementedObject(
+            const std::string& objectName) const;
+    ImplementedObjectsList getImplementedObjects(DbPluginHandle handle) const;
+    PluginObjectsDAO::ObjectsPtr getRequiredObjects(
+            DbPluginHandle handle) const;
+
+    /**
+     * Direct dependencies of plugin
+     */
+    PluginHandleSetPtr getLibraryDependencies(DbPluginHandle handle) const;
+
+    /**
+     * Plugin together with all its direct and indirect dependencies,
+     * ordered so that every plugin follows its dependencies
+     */
+    const PluginHandleList& getLoadOrder(DbPluginHandle handle) const;
+
+  private:
+    typedef std::map<std::string, DbPluginHandle> ObjectHandleMap;
+    typedef std::map<DbPluginHandle, ImplementedObjectsList> ObjectListMap;
+    typedef std::map<DbPluginHandle, PluginObjectsDAO::Objects> ObjectSetMap;
+    typedef std::map<DbPluginHandle, PluginHandleSet> DependencyMap;
+    typedef std::map<DbPluginHandle, PluginHandleList> LoadOrderMap;
+
+    explicit PluginGraph(int version);
+
+    void buildLoadOrder(DbPluginHandle handle,
+                        PluginHandleSet& visited,
+                        PluginHandleList& order) const;
+
+    int m_version;
+    ObjectHandleMap m_objectHandles;
+    ObjectListMap m_implementedObjects;
+    ObjectSetMap m_requiredObjects;
+    DependencyMap m_dependencies;
+    LoadOrderMap m_loadOrders;
+    PluginHandleList m_emptyLoadOrder;
+
+    friend class PluginDAOReadOnly;
+};
+
+typedef DPL::SharedPtr<const PluginGraph> PluginGraphPtr;
+
 //TODO make it friend to FeatureDAO or inherit
 class PluginDAOReadOnly
 {
@@ -100,6 +159,12 @@ class PluginDAOReadOnly
     static PluginInstallationState getInstallationStateForHandle(
             DbPluginHandle handle);
 
+    /**
+     * Get graph of installed plugins. Graph is cached in process and shared,
+     * validity of cached graph is checked with single query.
+     */
+    static PluginGraphPtr getPluginGraph();
+
     DbPluginHandle getPluginHandle() const;
     PluginInstallationState getInstallationStatus() const;
     std::string  getLibraryPath() const;
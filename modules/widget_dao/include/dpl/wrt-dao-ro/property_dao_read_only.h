@@ -24,6 +24,7 @@
 #define PROPERTY_DAO_READ_ONLY_H_
 
 #include <list>
+#include <stdint.h>
 #include <dpl/string.h>
 #include <dpl/exception.h>
 #include <dpl/db/orm.h>
@@ -46,6 +47,21 @@ struct WidgetPreferenceRow {
 
 typedef std::list<WidgetPreferenceRow> WidgetPreferenceList;
 
+/**
+ * Statistics of deferred preference writes, gathered in process
+ */
+struct FlushStatistics
+{
+    uint64_t writes;          ///< Property changes
+    uint64_t coalescedWrites; ///< Changes overwritten before reaching database
+    uint64_t flushes;         ///< Successful flush transactions
+    uint64_t failedFlushes;   ///< Flushes rolled back; their changes are lost
+    uint64_t flushedRows;     ///< Rows inserted, updated or deleted
+    uint64_t totalFlushTime;  ///< Time spent in flush transactions [us]
+    uint64_t maxFlushTime;    ///< Longest flush transaction [us]
+    uint64_t maxWriteDelay;   ///< Longest time from change to its flush [us]
+};
+
 /**
  * PropertyDAO Exception classes
  */
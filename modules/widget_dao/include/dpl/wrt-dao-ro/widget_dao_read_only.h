@@ -62,6 +62,23 @@ struct WidgetLocalizedInfo
     DPL::OptionalString licenseHref;
 };
 
+/**
+ * WidgetSummary
+ * A structure to hold basic information of installed widget, as presented
+ * in widget lists.
+ */
+struct WidgetSummary
+{
+    DbWidgetHandle handle;
+    WidgetGUID guid;
+    DPL::OptionalString pkgname;
+    WidgetType type;
+    DPL::OptionalString version;
+    DPL::OptionalString name;
+};
+
+typedef std::list<WidgetSummary> WidgetSummaryList;
+
 /**
  * CertificateData
  * A structure to hold certificate fingerprints.
@@ -546,6 +563,19 @@ class WidgetDAOReadOnly
      */
     static DbWidgetHandleList getHandleList();
 
+    /**
+     * This method returns summaries of all the installed widgets. Whole list
+     * is read with single query, so it should be used instead of calling
+     * getters for every handle returned by getHandleList().
+     *
+     * @param[in] languageTags Preferred languages of widget name, in order
+     *  of preference. Widget's default locale is tried after them.
+     * @return list of installed widgets' summaries, ordered by app id.
+     * @exception WRT_CONF_ERR_EMDB_FAILURE - Fail to query DB table.
+     */
+    static WidgetSummaryList getWidgetSummaries(
+            const LanguageTagList& languageTags);
+
    /**
      * This method removes a widget's information from EmDB.
      *
@@ -41,6 +41,22 @@ void SetProperty(DbWidgetHandle widgetHandle,
                  const PropertyDAOReadOnly::WidgetPropertyValue &value,
                  bool readOnly = false);
 
+/* This method sets time after which property changes are written to
+ * database [ms]. Changes are served from memory until then, and are
+ * written together in one transaction. Default 0 writes every change
+ * before the setter returns.
+ */
+void SetFlushDelay(unsigned long delay);
+
+/* This method writes all pending property changes. Inside caller's
+ * transaction it does nothing, changes are written after flush delay.
+ */
+void Sync();
+
+/* This method gets statistics of property writes
+ */
+PropertyDAOReadOnly::FlushStatistics GetFlushStatistics();
+
 /* This method registers properties for widget.
  * Properties unregistering is done via "delete cascade" mechanism in SQL
  */